@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "wheel.h"
+
+// micro-benchmark: timing wheel vs binary heap under the "hold" model
+// (pop the earliest event, schedule a new one a random delay later)
+
+// heap entry (seq breaks ties so equal expiries pop in insertion order)
+typedef struct HeapEntry {
+    int64_t expires;
+    uint64_t seq;
+} HeapEntry;
+
+// binary min-heap of events
+typedef struct Heap {
+    HeapEntry* entries;
+    int size;
+} Heap;
+
+// FUNCTION PROTOTYPES
+void heapPush(Heap* heap, HeapEntry entry);
+HeapEntry heapPop(Heap* heap);
+int heapLess(HeapEntry* a, HeapEntry* b);
+uint64_t nextRandom(uint64_t* state);
+double cpuTime();
+
+// check if heap entry a orders before b
+int heapLess(HeapEntry* a, HeapEntry* b) {
+    return a->expires < b->expires || (a->expires == b->expires && a->seq < b->seq);
+}
+
+// add an entry to the heap (sift up)
+void heapPush(Heap* heap, HeapEntry entry) {
+
+    int i = heap->size++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!heapLess(&entry, &heap->entries[parent])) {
+            break;
+        }
+        heap->entries[i] = heap->entries[parent];
+        i = parent;
+    }
+    heap->entries[i] = entry;
+}
+
+// remove the earliest entry from the heap (sift down)
+HeapEntry heapPop(Heap* heap) {
+
+    HeapEntry top = heap->entries[0];
+    HeapEntry last = heap->entries[--heap->size];
+
+    int i = 0;
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size && heapLess(&heap->entries[child + 1], &heap->entries[child])) {
+            child++;
+        }
+        if (!heapLess(&heap->entries[child], &last)) {
+            break;
+        }
+        heap->entries[i] = heap->entries[child];
+        i = child;
+    }
+    heap->entries[i] = last;
+
+    return top;
+}
+
+// xorshift64 random numbers (same sequence for both structures)
+uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// cpu time used so far in seconds
+double cpuTime() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// MAIN CALL
+int main(int argc, char* argv[]) {
+
+    // read benchmark size
+    int num_timers = (argc > 1) ? atoi(argv[1]) : 100000;
+    int num_ops = (argc > 2) ? atoi(argv[2]) : 10000000;
+    int64_t max_delay = (argc > 3) ? atoll(argv[3]) : 1000000;
+
+    if (num_timers <= 0 || num_ops <= 0 || max_delay <= 0) {
+        printf("INVALID CALL -- Usage ... ./bench_wheel [timers] [ops] [max delay]\n");
+        exit(1);
+    }
+
+    // allocate both structures
+    Wheel* wheel = (Wheel*) malloc(sizeof(Wheel));
+    Timer* timers = (Timer*) calloc(num_timers, sizeof(Timer));
+    Heap heap = { (HeapEntry*) malloc(num_timers * sizeof(HeapEntry)), 0 };
+    if (wheel == NULL || timers == NULL || heap.entries == NULL) {
+        printf("ERROR allocating memory for benchmark\n");
+        exit(1);
+    }
+
+    // timing wheel run
+    uint64_t rng = 88172645463325252ULL;
+    int64_t checksum_wheel = 0;
+    double start = cpuTime();
+
+    initWheel(wheel, 0);
+    for (int i = 0; i < num_timers; i++) {
+        addTimer(wheel, &timers[i], (int64_t) (nextRandom(&rng) % max_delay));
+    }
+    for (int i = 0; i < num_ops; i++) {
+        Timer* timer = popTimer(wheel, nextTimer(wheel));
+        checksum_wheel += timer->expires;
+        addTimer(wheel, timer, timer->expires + 1 + (int64_t) (nextRandom(&rng) % max_delay));
+    }
+
+    double wheel_secs = cpuTime() - start;
+
+    // binary heap run (same random sequence)
+    rng = 88172645463325252ULL;
+    int64_t checksum_heap = 0;
+    uint64_t seq = 0;
+    start = cpuTime();
+
+    for (int i = 0; i < num_timers; i++) {
+        HeapEntry entry = { (int64_t) (nextRandom(&rng) % max_delay), seq++ };
+        heapPush(&heap, entry);
+    }
+    for (int i = 0; i < num_ops; i++) {
+        HeapEntry entry = heapPop(&heap);
+        checksum_heap += entry.expires;
+        entry.expires += 1 + (int64_t) (nextRandom(&rng) % max_delay);
+        entry.seq = seq++;
+        heapPush(&heap, entry);
+    }
+
+    double heap_secs = cpuTime() - start;
+
+    // display results (checksums must match: both pop the same expiries)
+    printf("%d timers, %d pop+insert ops, delays up to %lld\n", num_timers, num_ops, (long long) max_delay);
+    printf("Timing wheel: %8.1f ns/op\n", wheel_secs * 1e9 / num_ops);
+    printf("Binary heap:  %8.1f ns/op\n", heap_secs * 1e9 / num_ops);
+    printf("Speedup: %.2fx%s\n", heap_secs / wheel_secs, checksum_wheel == checksum_heap ? "" : " (CHECKSUM MISMATCH)");
+
+    free(wheel);
+    free(timers);
+    free(heap.entries);
+
+    return 0;
+}
@@ -0,0 +1,1529 @@
+#include "schedule.h"
+
+// GLOBAL VARIABLES
+const int ARG_SIZE = 5;
+const int CHECKPOINT_VERSION = 2;
+const int CHECKPOINT_CHECK_EVENTS = 4096;   // events between clock checks
+const double CHECKPOINT_OVERHEAD = 0.01;    // max fraction of runtime spent writing snapshots
+const int TUNING_GRID = 8;                  // quanta tried per fine tuning pass
+
+// SCHEDULE FUNCTION DEFINITIONS
+
+// built-in policies (RR's quantum is set per run)
+const Policy POLICIES[] = {
+
+    // run arrivals in order, each to completion
+    { "FCFS", addNodeRR, removeNode, NULL, 0, false },
+
+    // shortest remaining first, preempted by shorter arrivals
+    { "SJF", addNode, removeNode, preemptShorter, 0, false },
+
+    // highest priority (lowest value) ready process runs to completion
+    { "PS", addNodeRR, removeNodePriority, NULL, 0, false },
+
+    // FIFO ready list, each process runs for at most one quantum at a time
+    // (its own quantum if set, else the run's)
+    { "RR", addNodeRR, removeNode, NULL, 0, true },
+};
+const int NUM_POLICIES = sizeof(POLICIES) / sizeof(Policy);
+
+// find built-in policy by name (case-insensitive, NULL if unknown)
+const Policy* findPolicy(const char* name) {
+
+    for (int i = 0; i < NUM_POLICIES; i++) {
+        if (strcasecmp(POLICIES[i].name, name) == 0) {
+            return &POLICIES[i];
+        }
+    }
+
+    return NULL;
+}
+
+// SIMULATION ENGINE DEFINITIONS
+
+// run processes (sorted by arrival/pid) under a policy, jumping from event to
+// event (arrival, completion, quantum expiry, preemption); sets end_time
+SchedStatus simulate(const Policy* policy, RL* rl, Process** processes, int num_processes, Gantt* gantt, int64_t* end_time) {
+    return simulateWith(policy, rl, processes, num_processes, gantt, end_time, NULL, NULL, NULL, NULL, NULL);
+}
+
+// simulate, stopping early once the run's cost must exceed bound's limit
+// (bound = NULL runs to completion; bounded runs don't checkpoint or resume),
+// sampling a time series into telemetry (NULL = none) and taking processes
+// from source as they're parsed (NULL = all in processes already; streamed
+// runs don't checkpoint or resume, and stop if arrivals are out of order),
+// keeping in-memory snapshots in history (NULL = none), which may also hold
+// a snapshot to start from (processes admitted before it must hold their
+// results and gantt its slices), and writing/resuming from checkpoint files
+// as set in checkpointing (NULL = none)
+SchedStatus simulateWith(const Policy* policy, RL* rl, Process** processes, int num_processes, Gantt* gantt, \
+    int64_t* end_time, Bound* bound, Telemetry* telemetry, ArrivalSource* source, History* history, \
+    Checkpointing* checkpointing) {
+
+    PHASE_BEGIN(PHASE_SIMULATE);
+
+    // streamed processes are set up as they're loaded
+    Snapshot* snapshot = (history != NULL) ? history->resume : NULL;
+    if (source == NULL) {
+
+        // reset all process fields to default (but keep those admitted before a snapshot)
+        // (processes are already sorted by arrival, see sortProcesses)
+        int first = (snapshot != NULL) ? snapshot->next : 0;
+        wipeProcessTimes(&processes[first], num_processes - first);
+
+        // record arrival order (checkpoints refer to processes by index)
+        for (int i = 0; i < num_processes; i++) {
+            processes[i]->index = i;
+        }
+    }
+
+    // variables to manage processes and time
+    Sim sim = { 0, 0, 0, NULL, 0, 0 };
+    SchedStatus status = SCHED_OK;
+
+    // RL never holds more than every process, so it can't run out of nodes mid-run
+    if (!reserveNodes(rl, num_processes)) {
+        PHASE_END(PHASE_SIMULATE);
+        return SCHED_ERR_MEMORY;
+    }
+
+    // checkpoint files (bounded and streamed runs don't use them)
+    if (bound != NULL || source != NULL) {
+        checkpointing = NULL;
+    }
+
+    // pick up where the checkpoint left off
+    if (checkpointing != NULL && checkpointing->resume != NULL) {
+        status = restoreCheckpoint(checkpointing->resume, policy, rl, processes, num_processes, &sim, gantt);
+        freeCheckpoint(checkpointing->resume);
+        checkpointing->resume = NULL;
+        if (status != SCHED_OK) {
+            PHASE_END(PHASE_SIMULATE);
+            return status;
+        }
+    }
+
+    // pick up where an in-memory snapshot left off
+    if (snapshot != NULL && !restoreSnapshot(snapshot, rl, processes, &sim)) {
+        PHASE_END(PHASE_SIMULATE);
+        return SCHED_ERR_MEMORY;
+    }
+    if (history != NULL) {
+        history->next_at = sim.next + history->interval;
+    }
+
+    // event queue: an arrival timer per process not yet admitted,
+    // plus the running process's completion/quantum expiry timer
+    Wheel* wheel = (Wheel*) malloc(sizeof(Wheel));
+    Timer* arrivals = (Timer*) calloc(num_processes + 1, sizeof(Timer));
+    STAT_ADD(allocations, 2);
+    Timer run_timer = { 0, NULL, NULL, NULL, 0, 0 };
+    if (wheel == NULL || arrivals == NULL) {
+        free(wheel);
+        free(arrivals);
+        PHASE_END(PHASE_SIMULATE);
+        return SCHED_ERR_MEMORY;
+    }
+    initWheel(wheel, sim.time);
+    for (int i = sim.next; source == NULL && i < num_processes; i++) {
+        arrivals[i].data = processes[i];
+        addTimer(wheel, &arrivals[i], processes[i]->arrival);
+    }
+    if (sim.p != NULL) {
+        addTimer(wheel, &run_timer, runEnd(policy, sim.p, sim.slice_left, sim.time));
+    }
+
+    // time series starts with the run (or where it resumed)
+    if (telemetry != NULL) {
+        startTelemetry(telemetry, policy->name, &sim, gantt);
+    }
+
+    // vars to pace checkpoints
+    const char* checkpoint_path = (checkpointing != NULL) ? checkpointing->path : NULL;
+    double checkpoint_interval = (checkpointing != NULL) ? checkpointing->interval : 0.0;
+    double next_checkpoint = wallTime() + checkpoint_interval;
+    uint64_t events = 0;    // 64-bit so long runs can't wrap it
+
+    // loop until all processes are done
+    while (sim.completed < num_processes) {
+
+        STAT_INC(events);
+
+        // snapshot state, checking the clock only every so many events
+        if (checkpoint_path != NULL && ++events % CHECKPOINT_CHECK_EVENTS == 0 && wallTime() >= next_checkpoint) {
+
+            double cost = wallTime();
+            status = saveCheckpoint(checkpoint_path, policy, rl, processes, num_processes, &sim, gantt);
+            if (status != SCHED_OK) {
+                break;
+            }
+            cost = wallTime() - cost;
+
+            // wait long enough that snapshots stay a small fraction of runtime
+            double wait = cost / CHECKPOINT_OVERHEAD;
+            next_checkpoint = wallTime() + (wait > checkpoint_interval ? wait : checkpoint_interval);
+        }
+
+        // keep a snapshot every so many admitted processes
+        if (history != NULL && history->interval > 0 && sim.next >= history->next_at) {
+            if (!takeSnapshot(history, rl, &sim, gantt)) {
+                status = SCHED_ERR_MEMORY;
+                break;
+            }
+            history->next_at = sim.next + history->interval;
+        }
+
+        // make sure every arrival so far is loaded
+        if (source != NULL) {
+            status = loadArrivals(source, wheel, arrivals, sim.next, sim.time);
+            if (status != SCHED_OK) {
+                break;
+            }
+        }
+
+        // add processes that have arrived to RL
+        admitArrivals(policy, rl, wheel, &sim.next, sim.time);
+
+        // dispatch a process if cpu is free
+        if (sim.p == NULL) {
+
+            // nothing ready, idle until the next arrival
+            if (isEmpty(rl)) {
+
+                // load the next arrival and any others at the same time
+                if (source != NULL) {
+                    status = loadArrivals(source, wheel, arrivals, sim.next, INT64_MIN);
+                    if (status == SCHED_OK) {
+                        status = loadArrivals(source, wheel, arrivals, sim.next, processes[sim.next]->arrival);
+                    }
+                    if (status != SCHED_OK) {
+                        break;
+                    }
+                }
+
+                int64_t arrival = nextTimer(wheel);
+                if (!addSlice(gantt, -1, sim.time, arrival)) {
+                    status = SCHED_ERR_MEMORY;
+                    break;
+                }
+                if (telemetry != NULL) {
+                    recordTelemetry(telemetry, processes, num_processes, sim.next, 0, -1, sim.time, arrival);
+                }
+                sim.time = arrival;
+                continue;
+            }
+
+            // get next process from ready list
+            sim.p = dispatchNext(policy, rl, sim.time, &sim.slice_left);
+            sim.slice_start = sim.time;
+
+            // each dispatch is a context switch
+            if (bound != NULL) {
+                bound->dispatches++;
+                if (exceedsBound(bound, NULL, num_processes)) {
+                    bound->exceeded = true;
+                    break;
+                }
+            }
+
+            // time completion or quantum expiry
+            addTimer(wheel, &run_timer, runEnd(policy, sim.p, sim.slice_left, sim.time));
+        }
+
+        // load arrivals up to the end of the run (before looking for an
+        // earlier arrival, timers can't be added behind the wheel)
+        if (source != NULL) {
+            status = loadArrivals(source, wheel, arrivals, sim.next, run_timer.expires);
+            if (status != SCHED_OK) {
+                break;
+            }
+        }
+
+        // run until the next event: completion, quantum expiry,
+        // or (for preemptive policies) the next arrival
+        Process* p = sim.p;
+        int64_t event = run_timer.expires;
+        if (policy->preempt != NULL) {
+            event = nextTimer(wheel);
+        }
+
+        if (telemetry != NULL) {
+            recordTelemetry(telemetry, processes, num_processes, sim.next, rl->size, p->pid, sim.time, event);
+        }
+
+        int64_t run = event - sim.time;
+        sim.time = event;
+        p->remaining -= run;
+        sim.slice_left -= run;
+
+        // run ends on completion or quantum expiry
+        if (run_timer.expires == sim.time) {
+            cancelTimer(wheel, &run_timer);
+        }
+
+        // check if process is done
+        if (p->remaining == 0) {
+
+            sim.completed++;
+            sim.p = NULL;
+            if (!finishProcess(gantt, p, sim.slice_start, sim.time)) {
+                status = SCHED_ERR_MEMORY;
+                break;
+            }
+
+            // stop a bounded run once it can't beat the limit
+            if (bound != NULL && exceedsBound(bound, p, num_processes)) {
+                bound->exceeded = true;
+                break;
+            }
+
+        // quantum used up
+        } else if (policy->quantum > 0 && sim.slice_left == 0) {
+
+            sim.p = NULL;
+            if (!expireQuantum(policy, rl, wheel, &sim.next, gantt, p, sim.slice_start, sim.time)) {
+                status = SCHED_ERR_MEMORY;
+                break;
+            }
+
+        // an arrival preempts the process
+        } else if (policy->preempt != NULL && checkPreemption(policy, p, processes, num_processes, sim.next, sim.time)) {
+
+            sim.p = NULL;
+            if (!preemptProcess(policy, rl, wheel, &run_timer, gantt, p, sim.slice_start, sim.time)) {
+                status = SCHED_ERR_MEMORY;
+                break;
+            }
+        }
+    }
+
+    free(wheel);
+    free(arrivals);
+
+    // leave RL empty for the next run
+    clearRL(rl);
+
+    *end_time = sim.time;
+
+    PHASE_END(PHASE_SIMULATE);
+
+    return status;
+}
+
+// add a finished process (or NULL after a dispatch) to a bounded run's cost;
+// true once the final cost must exceed the bound's limit
+bool exceedsBound(Bound* bound, Process* finished, int num_processes) {
+
+    double switches = bound->switch_weight * bound->dispatches / num_processes;
+
+    // average waiting only grows as processes finish
+    if (bound->objective == SCHED_OBJECTIVE_AVG_WAITING) {
+        if (finished != NULL) {
+            bound->total_waiting += finished->waiting;
+        }
+        return bound->total_waiting / num_processes + switches > bound->limit;
+    }
+
+    // p99 waiting exceeds limit once more processes than the top 1% waited longer
+    // (switch cost only grows, so earlier counts stay valid)
+    if (finished != NULL && finished->waiting > bound->limit - switches) {
+        bound->over++;
+    }
+
+    return bound->over > num_processes - p99Rank(num_processes);
+}
+
+// 1-based rank of the 99th percentile among num_processes values (nearest rank)
+int p99Rank(int num_processes) {
+    return (int) (((int64_t) num_processes * 99 + 99) / 100);
+}
+
+// take batches from source until every arrival by time is loaded (and at least
+// one process past next), setting up each process and its arrival timer
+SchedStatus loadArrivals(ArrivalSource* source, Wheel* wheel, Timer* arrivals, int next, int64_t time) {
+
+    Process** processes = source->processes;
+
+    while (source->loaded < source->num_processes && \
+    (source->loaded == next || processes[source->loaded - 1]->arrival <= time)) {
+
+        // wait for the parser's next batch
+        int end = nextBatch(source);
+        if (__atomic_load_n(&source->unsorted, __ATOMIC_RELAXED)) {
+            return SCHED_ERR_UNSORTED;
+        }
+
+        // reset process fields, record arrival order and time arrival
+        for (int i = source->loaded; i < end; i++) {
+            wipeProcessTimes(&processes[i], 1);
+            processes[i]->index = i;
+            arrivals[i].data = processes[i];
+            addTimer(wheel, &arrivals[i], processes[i]->arrival);
+        }
+        source->loaded = end;
+    }
+
+    return SCHED_OK;
+}
+
+// run steps shared with simulateCpus, so both loops dispatch, finish and
+// requeue processes the same way
+
+// take the next process off RL to run from time, setting slice_left to its
+// quantum (its own if the policy has job quanta and it set one)
+Process* dispatchNext(const Policy* policy, RL* rl, int64_t time, int64_t* slice_left) {
+
+    Process* p = policy->pickNext(rl);
+
+    // update process start time on first dispatch
+    if (p->remaining == p->burst) {
+        p->start = time;
+    }
+
+    *slice_left = policy->quantum;
+    if (policy->job_quanta && p->quantum > 0) {
+        *slice_left = p->quantum;
+    }
+
+    return p;
+}
+
+// time p's current run ends (completion or quantum expiry) if it makes
+// progress from time with slice_left of its quantum left
+int64_t runEnd(const Policy* policy, Process* p, int64_t slice_left, int64_t time) {
+
+    int64_t run = p->remaining;
+    if (policy->quantum > 0 && slice_left < run) {
+        run = slice_left;
+    }
+
+    return time + run;
+}
+
+// p ran to completion at time: record its results and close its slice
+// (false if out of memory)
+bool finishProcess(Gantt* gantt, Process* p, int64_t slice_start, int64_t time) {
+
+    // mark process as finished
+    p->finished = true;
+
+    // update process completion time
+    p->complete = time;
+
+    // compute turnaround (completion - arrival) and waiting (turnaround - burst)
+    p->turnaround = time - p->arrival;
+    p->waiting = p->turnaround - p->burst;
+
+    return addSlice(gantt, p->pid, slice_start, time);
+}
+
+// p's quantum expired at time, arrivals during the quantum go ahead of it
+bool expireQuantum(const Policy* policy, RL* rl, Wheel* wheel, int* next, Gantt* gantt, Process* p, \
+    int64_t slice_start, int64_t time) {
+
+    admitArrivals(policy, rl, wheel, next, time);
+    return requeueProcess(policy, rl, gantt, p, slice_start, time, "quantum expired");
+}
+
+// an arrival preempted p at time, it goes back ahead of the arrivals
+bool preemptProcess(const Policy* policy, RL* rl, Wheel* wheel, Timer* run_timer, Gantt* gantt, Process* p, \
+    int64_t slice_start, int64_t time) {
+
+    cancelTimer(wheel, run_timer);
+    return requeueProcess(policy, rl, gantt, p, slice_start, time, "preempted");
+}
+
+// put an unfinished p back in RL, closing its slice and marking why in the trace
+bool requeueProcess(const Policy* policy, RL* rl, Gantt* gantt, Process* p, int64_t slice_start, int64_t time, \
+    const char* reason) {
+
+    policy->enqueue(rl, p);
+    if (!addSlice(gantt, p->pid, slice_start, time)) {
+        return false;
+    }
+    if (gantt->trace != NULL) {
+        traceMark(gantt->trace, gantt->cpu, reason, p->pid, time);
+    }
+
+    return true;
+}
+
+// add all processes arrived by time to the ready list
+void admitArrivals(const Policy* policy, RL* rl, Wheel* wheel, int* next, int64_t time) {
+
+    // arrival timers fire in arrival order
+    Timer* timer;
+    while ((timer = popTimer(wheel, time)) != NULL) {
+
+        // add process to ready list
+        Process* p = (Process*) timer->data;
+        policy->enqueue(rl, p);
+
+        // mark process as visited
+        p->visited = true;
+
+        (*next)++;
+    }
+}
+
+// check if any process arrived by time (not yet admitted) preempts p
+bool checkPreemption(const Policy* policy, Process* p, Process** processes, int num_processes, int next, int64_t time) {
+
+    for (int i = next; i < num_processes && processes[i]->arrival <= time; i++) {
+        if (policy->preempt(p, processes[i])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// SJF preemption hook: arrival has less time remaining than running process
+bool preemptShorter(Process* running, Process* arrival) {
+    return arrival->remaining < running->remaining;
+}
+
+// print waiting/turnaround, gantt chart (one per cpu) and overall stats of a
+// schedule, plus migration stats of a multi-cpu run (machine = NULL for none)
+void printSchedule(FILE* out, const char* name, Process** processes, int num_processes, Gantt* gantts, int num_gantts, \
+    int64_t time, Machine* machine) {
+
+    // print policy stats
+    fprintf(out, "\n---------------------------- %s ----------------------------\n", name);
+    fprintf(out, "\tPID\t|\tWaiting \t|\tTurnaround\n");
+    for (int i = 0; i < num_processes; i++) {
+
+        // print waiting/turnaround times
+        fprintf(out, "\t %d\t|\t   %" PRId64 "\t\t|\t   %" PRId64 "\n", processes[i]->pid, processes[i]->waiting, processes[i]->turnaround);
+    }
+    fprintf(out, "\n");
+
+    // print gantt chart of each cpu (unless it was only streamed to a trace)
+    for (int c = 0; c < num_gantts; c++) {
+        Gantt* gantt = &gantts[c];
+
+        if (num_gantts == 1) {
+            fprintf(out, "Gantt Chart:\n");
+        } else {
+            fprintf(out, "Gantt Chart (CPU %d):\n", c);
+        }
+        if (gantt->discard) {
+            fprintf(out, "(streamed to trace)\n");
+        }
+        for (int i = 0; i < gantt->size; i++) {
+
+            // print idle time or process lifecycle
+            if (gantt->pid[i] == -1) {
+                fprintf(out, "[  %" PRId64 "  ]-----\tIDLE\t-----[  %" PRId64 "  ]\n", gantt->start[i], gantt->end[i]);    
+            } else {
+                fprintf(out, "[  %" PRId64 "  ]-----\t%d\t-----[  %" PRId64 "  ]\n", gantt->start[i], gantt->pid[i], gantt->end[i]);
+            }
+        }
+        fprintf(out, "\n");
+    }
+
+    // vars for time stats
+    double avg_turnaround = 0.0;
+    double avg_waiting = 0.0;
+    double throughput = (double) num_processes / time;
+
+    // calculate average turnaround & waiting times
+    for (int i = 0; i < num_processes; i++) {
+        avg_turnaround += processes[i]->turnaround;
+        avg_waiting += processes[i]->waiting;
+    }
+
+    avg_turnaround /= num_processes;
+    avg_waiting /= num_processes;
+
+    // display overall schedule stats
+    fprintf(out, "Avg. Waiting Time: %f\n", avg_waiting);
+    fprintf(out, "Avg. Turnaround: %f\n", avg_turnaround);
+    fprintf(out, "Throughput: %f\n", throughput);
+    if (machine != NULL) {
+        fprintf(out, "CPUs: %d (%s)\n", machine->num_cpus, machine->affinity ? "affinity" : "no affinity");
+        fprintf(out, "Migrations: %" PRId64 "\n", machine->migrations);
+        fprintf(out, "Cold Restarts: %" PRId64 "\n", machine->cold_restarts);
+        fprintf(out, "Penalty Time: %" PRId64 "\n", machine->penalty);
+    }
+    fprintf(out, "\n");
+}
+
+// QUANTUM TUNING FUNCTIONS
+
+// find the round robin quantum (one for every process) with the lowest cost
+// (objective + switch_weight * context switches per process), searching
+// doubling quanta up to the longest burst, then finer grids around the best;
+// runs stop early once they can't beat the best so far
+SchedStatus tuneQuantum(RL* rl, Process** processes, int num_processes, Tuning* tuning) {
+
+    tuning->quantum = 0;
+    tuning->cost = DBL_MAX;
+    tuning->runs = 0;
+    tuning->cut_short = 0;
+
+    if (num_processes == 0) {
+        return SCHED_ERR_EMPTY;
+    }
+
+    // quanta past the longest burst all run every process to completion
+    int64_t max_burst = 1;
+    for (int i = 0; i < num_processes; i++) {
+        if (processes[i]->burst > max_burst) {
+            max_burst = processes[i]->burst;
+        }
+    }
+
+    // scratch space shared by every run
+    Gantt gantt;
+    int64_t* waiting = (int64_t*) malloc(num_processes * sizeof(int64_t));
+    if (waiting == NULL || !initGantt(&gantt, num_processes * 2)) {
+        free(waiting);
+        return SCHED_ERR_MEMORY;
+    }
+
+    // coarse pass: 1, 2, 4, ... max burst
+    SchedStatus status = SCHED_OK;
+    for (int64_t quantum = 1; status == SCHED_OK; quantum *= 2) {
+        if (quantum >= max_burst) {
+            quantum = max_burst;
+        }
+        status = tryQuantum(rl, processes, num_processes, quantum, tuning, &gantt, waiting);
+        if (quantum == max_burst) {
+            break;
+        }
+    }
+
+    // fine passes: grids between the best quantum's neighbours, narrowing to step 1
+    int64_t low = (tuning->quantum / 2 > 1) ? tuning->quantum / 2 : 1;
+    int64_t high = (tuning->quantum <= max_burst / 2) ? tuning->quantum * 2 : max_burst;
+    while (status == SCHED_OK) {
+
+        int64_t step = (high - low) / TUNING_GRID;
+        if (step < 1) {
+            step = 1;
+        }
+
+        for (int64_t quantum = low; quantum <= high && status == SCHED_OK; quantum += step) {
+            if (quantum != tuning->quantum) {
+                status = tryQuantum(rl, processes, num_processes, quantum, tuning, &gantt, waiting);
+            }
+        }
+
+        if (step == 1) {
+            break;
+        }
+        low = (tuning->quantum - step > 1) ? tuning->quantum - step : 1;
+        high = (tuning->quantum + step < max_burst) ? tuning->quantum + step : max_burst;
+    }
+
+    freeGantt(&gantt);
+    free(waiting);
+
+    return status;
+}
+
+// simulate round robin with quantum, keeping it if it beats tuning's best
+SchedStatus tryQuantum(RL* rl, Process** processes, int num_processes, int64_t quantum, Tuning* tuning, \
+    Gantt* gantt, int64_t* waiting) {
+
+    // same quantum for every process
+    Policy policy = *findPolicy("RR");
+    policy.quantum = quantum;
+    policy.job_quanta = false;
+
+    // run, stopping once the best so far can't be beaten
+    Bound bound = { tuning->objective, tuning->switch_weight, tuning->cost, false, 0, 0.0, 0 };
+    resetGantt(gantt);
+    int64_t time;
+    SchedStatus status = simulateWith(&policy, rl, processes, num_processes, gantt, &time, &bound, NULL, NULL, NULL, NULL);
+    if (status != SCHED_OK) {
+        return status;
+    }
+
+    tuning->runs++;
+    if (bound.exceeded) {
+        tuning->cut_short++;
+        return SCHED_OK;
+    }
+
+    // cost of the finished run
+    double cost = bound.switch_weight * bound.dispatches / num_processes;
+    if (tuning->objective == SCHED_OBJECTIVE_AVG_WAITING) {
+        cost += bound.total_waiting / num_processes;
+    } else {
+        for (int i = 0; i < num_processes; i++) {
+            waiting[i] = processes[i]->waiting;
+        }
+        qsort(waiting, num_processes, sizeof(int64_t), timeDiff);
+        cost += waiting[p99Rank(num_processes) - 1];
+    }
+
+    if (cost < tuning->cost) {
+        tuning->quantum = quantum;
+        tuning->cost = cost;
+    }
+
+    return SCHED_OK;
+}
+
+// CHECKPOINT FUNCTIONS
+
+// write a snapshot of the running simulation (via a temp file so a crash
+// mid-write leaves the previous snapshot intact)
+SchedStatus saveCheckpoint(const char* path, const Policy* policy, RL* rl, Process** processes, int num_processes, Sim* sim, Gantt* gantt) {
+
+    // fill in header
+    Checkpoint ckpt;
+    memset(&ckpt, 0, sizeof(Checkpoint));
+    memcpy(ckpt.magic, "SCHK", 4);
+    ckpt.version = CHECKPOINT_VERSION;
+    strncpy(ckpt.policy, policy->name, sizeof(ckpt.policy) - 1);
+    ckpt.quantum = policy->quantum;
+    ckpt.num_processes = num_processes;
+    ckpt.input_hash = hashInput(processes, num_processes);
+    ckpt.time = sim->time;
+    ckpt.completed = sim->completed;
+    ckpt.next = sim->next;
+    ckpt.running = (sim->p == NULL) ? -1 : sim->p->index;
+    ckpt.slice_start = sim->slice_start;
+    ckpt.slice_left = sim->slice_left;
+    ckpt.num_slices = gantt->size;
+    ckpt.num_ready = rl->size;
+
+    // open temp file next to the checkpoint
+    char tmp_path[strlen(path) + 5];
+    sprintf(tmp_path, "%s.tmp", path);
+    FILE* file_ptr = fopen(tmp_path, "wb");
+    if (file_ptr == NULL) {
+        return SCHED_ERR_CHECKPOINT_IO;
+    }
+
+    // write header, RL, admitted processes and gantt
+    fwrite(&ckpt, offsetof(Checkpoint, ready), 1, file_ptr);
+    for (Node* node = rl->head; node != NULL; node = node->next) {
+        fwrite(&node->process->index, sizeof(int), 1, file_ptr);
+    }
+    for (int i = 0; i < sim->next; i++) {
+        int64_t job[3] = { processes[i]->remaining, processes[i]->start, processes[i]->complete };
+        fwrite(job, sizeof(int64_t), 3, file_ptr);
+    }
+    for (int i = 0; i < gantt->size; i++) {
+        int64_t slice[3] = { gantt->pid[i], gantt->start[i], gantt->end[i] };
+        fwrite(slice, sizeof(int64_t), 3, file_ptr);
+    }
+
+    // replace previous snapshot
+    bool failed = ferror(file_ptr);
+    if (fclose(file_ptr) != 0 || failed || rename(tmp_path, path) != 0) {
+        remove(tmp_path);
+        return SCHED_ERR_CHECKPOINT_IO;
+    }
+
+    return SCHED_OK;
+}
+
+// read a snapshot written by saveCheckpoint into *out
+SchedStatus loadCheckpoint(const char* path, Checkpoint** out) {
+
+    // open checkpoint file
+    FILE* file_ptr = fopen(path, "rb");
+    if (file_ptr == NULL) {
+        return SCHED_ERR_CHECKPOINT_IO;
+    }
+
+    // alloc mem for checkpoint (arrays NULL until read so it can always be freed)
+    Checkpoint* ckpt = (Checkpoint*) calloc(1, sizeof(Checkpoint));
+    if (ckpt == NULL) {
+        fclose(file_ptr);
+        return SCHED_ERR_MEMORY;
+    }
+
+    // read and check header
+    SchedStatus status = SCHED_OK;
+    if (fread(ckpt, offsetof(Checkpoint, ready), 1, file_ptr) != 1 || memcmp(ckpt->magic, "SCHK", 4) != 0 || \
+    ckpt->version != CHECKPOINT_VERSION || ckpt->next < 0 || ckpt->next > ckpt->num_processes || \
+    ckpt->num_ready < 0 || ckpt->num_slices < 0) {
+        status = SCHED_ERR_CHECKPOINT_INVALID;
+    }
+    ckpt->policy[sizeof(ckpt->policy) - 1] = '\0';
+
+    // read variable-length data
+    if (status == SCHED_OK) {
+        ckpt->ready = (int*) malloc((ckpt->num_ready + 1) * sizeof(int));
+        ckpt->jobs = (int64_t*) malloc((ckpt->next * 3 + 1) * sizeof(int64_t));
+        ckpt->slices = (int64_t*) malloc((ckpt->num_slices * 3 + 1) * sizeof(int64_t));
+        if (ckpt->ready == NULL || ckpt->jobs == NULL || ckpt->slices == NULL) {
+            status = SCHED_ERR_MEMORY;
+        }
+    }
+    if (status == SCHED_OK && \
+    (fread(ckpt->ready, sizeof(int), ckpt->num_ready, file_ptr) != (size_t) ckpt->num_ready || \
+    fread(ckpt->jobs, sizeof(int64_t), ckpt->next * 3, file_ptr) != (size_t) ckpt->next * 3 || \
+    fread(ckpt->slices, sizeof(int64_t), ckpt->num_slices * 3, file_ptr) != (size_t) ckpt->num_slices * 3)) {
+        status = SCHED_ERR_CHECKPOINT_INVALID;
+    }
+
+    fclose(file_ptr);
+
+    if (status != SCHED_OK) {
+        freeCheckpoint(ckpt);
+        return status;
+    }
+
+    *out = ckpt;
+
+    return SCHED_OK;
+}
+
+// load snapshot state into a fresh (wiped and sorted) simulation
+SchedStatus restoreCheckpoint(Checkpoint* ckpt, const Policy* policy, RL* rl, Process** processes, int num_processes, Sim* sim, Gantt* gantt) {
+
+    // check snapshot was taken from this input and policy
+    if (ckpt->num_processes != num_processes || ckpt->quantum != policy->quantum || \
+    ckpt->input_hash != hashInput(processes, num_processes)) {
+        return SCHED_ERR_CHECKPOINT_MISMATCH;
+    }
+
+    // check saved indices are in range
+    for (int i = 0; i < ckpt->num_ready; i++) {
+        if (ckpt->ready[i] < 0 || ckpt->ready[i] >= ckpt->next) {
+            return SCHED_ERR_CHECKPOINT_INVALID;
+        }
+    }
+    if (ckpt->running < -1 || ckpt->running >= ckpt->next) {
+        return SCHED_ERR_CHECKPOINT_INVALID;
+    }
+
+    // restore admitted processes
+    for (int i = 0; i < ckpt->next; i++) {
+        Process* p = processes[i];
+        p->remaining = ckpt->jobs[i * 3];
+        p->start = ckpt->jobs[i * 3 + 1];
+        p->complete = ckpt->jobs[i * 3 + 2];
+        p->visited = true;
+        p->finished = (p->remaining == 0);
+        if (p->finished) {
+            p->turnaround = p->complete - p->arrival;
+            p->waiting = p->turnaround - p->burst;
+        }
+    }
+
+    // rebuild RL in saved order
+    for (int i = 0; i < ckpt->num_ready; i++) {
+        addNodeRR(rl, processes[ckpt->ready[i]]);
+    }
+
+    // rebuild gantt timeline
+    for (int i = 0; i < ckpt->num_slices; i++) {
+        if (!addSlice(gantt, (int) ckpt->slices[i * 3], ckpt->slices[i * 3 + 1], ckpt->slices[i * 3 + 2])) {
+            return SCHED_ERR_MEMORY;
+        }
+    }
+
+    // restore engine state
+    sim->time = ckpt->time;
+    sim->completed = ckpt->completed;
+    sim->next = ckpt->next;
+    sim->p = (ckpt->running == -1) ? NULL : processes[ckpt->running];
+    sim->slice_start = ckpt->slice_start;
+    sim->slice_left = ckpt->slice_left;
+
+    return SCHED_OK;
+}
+
+// free checkpoint memory
+void freeCheckpoint(Checkpoint* ckpt) {
+    free(ckpt->ready);
+    free(ckpt->jobs);
+    free(ckpt->slices);
+    free(ckpt);
+}
+
+// fingerprint the input fields of processes (FNV-1a)
+unsigned long long hashInput(Process** processes, int num_processes) {
+
+    unsigned long long hash = 14695981039346656037ULL;
+
+    for (int i = 0; i < num_processes; i++) {
+        int64_t fields[ARG_SIZE];
+        fields[0] = processes[i]->pid;
+        fields[1] = processes[i]->arrival;
+        fields[2] = processes[i]->burst;
+        fields[3] = processes[i]->priority;
+        fields[4] = processes[i]->quantum;
+
+        for (int j = 0; j < ARG_SIZE; j++) {
+            hash = (hash ^ (unsigned long long) fields[j]) * 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
+
+// current wall clock time in seconds
+double wallTime() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// SNAPSHOT FUNCTIONS
+
+// initialize an empty history, snapshotting every interval admitted processes (0 = never)
+void initHistory(History* history, int interval) {
+    memset(history, 0, sizeof(History));
+    history->interval = interval;
+}
+
+// take a spot for a new snapshot, growing the history when full (NULL if out of memory)
+static Snapshot* appendSnapshot(History* history) {
+
+    if (history->count == history->capacity) {
+        int capacity = (history->capacity == 0) ? 16 : history->capacity * 2;
+        Snapshot* snapshots = (Snapshot*) realloc(history->snapshots, capacity * sizeof(Snapshot));
+        STAT_INC(allocations);
+        if (snapshots == NULL) {
+            return NULL;
+        }
+        history->snapshots = snapshots;
+        history->capacity = capacity;
+    }
+
+    return &history->snapshots[history->count];
+}
+
+// add a snapshot of the running simulation to history (false if out of memory)
+bool takeSnapshot(History* history, RL* rl, Sim* sim, Gantt* gantt) {
+
+    Snapshot* snapshot = appendSnapshot(history);
+    if (snapshot == NULL) {
+        return false;
+    }
+
+    int num_jobs = rl->size + (sim->p != NULL);
+    snapshot->ready = (int*) malloc((rl->size + 1) * sizeof(int));
+    snapshot->jobs = (int64_t*) malloc((num_jobs * 2 + 1) * sizeof(int64_t));
+    STAT_ADD(allocations, 2);
+    if (snapshot->ready == NULL || snapshot->jobs == NULL) {
+        free(snapshot->ready);
+        free(snapshot->jobs);
+        return false;
+    }
+
+    snapshot->time = sim->time;
+    snapshot->completed = sim->completed;
+    snapshot->next = sim->next;
+    snapshot->running = (sim->p == NULL) ? -1 : sim->p->index;
+    snapshot->slice_start = sim->slice_start;
+    snapshot->slice_left = sim->slice_left;
+    snapshot->num_slices = gantt->size;
+    snapshot->num_ready = rl->size;
+
+    // RL from head, then the running process
+    int i = 0;
+    for (Node* node = rl->head; node != NULL; node = node->next, i++) {
+        snapshot->ready[i] = node->process->index;
+        snapshot->jobs[i * 2] = node->process->remaining;
+        snapshot->jobs[i * 2 + 1] = node->process->start;
+    }
+    if (sim->p != NULL) {
+        snapshot->jobs[i * 2] = sim->p->remaining;
+        snapshot->jobs[i * 2 + 1] = sim->p->start;
+    }
+
+    history->count++;
+
+    return true;
+}
+
+// add a copy of another run's snapshot to history (false if out of memory)
+bool copySnapshot(History* history, const Snapshot* snapshot) {
+
+    Snapshot* copy = appendSnapshot(history);
+    if (copy == NULL) {
+        return false;
+    }
+
+    int num_jobs = snapshot->num_ready + (snapshot->running != -1);
+    *copy = *snapshot;
+    copy->ready = (int*) malloc((snapshot->num_ready + 1) * sizeof(int));
+    copy->jobs = (int64_t*) malloc((num_jobs * 2 + 1) * sizeof(int64_t));
+    STAT_ADD(allocations, 2);
+    if (copy->ready == NULL || copy->jobs == NULL) {
+        free(copy->ready);
+        free(copy->jobs);
+        return false;
+    }
+    memcpy(copy->ready, snapshot->ready, snapshot->num_ready * sizeof(int));
+    memcpy(copy->jobs, snapshot->jobs, num_jobs * 2 * sizeof(int64_t));
+
+    history->count++;
+
+    return true;
+}
+
+// load snapshot state into a fresh simulation (processes admitted before it
+// are marked finished, except those it has in RL or running)
+bool restoreSnapshot(Snapshot* snapshot, RL* rl, Process** processes, Sim* sim) {
+
+    for (int i = 0; i < snapshot->next; i++) {
+        processes[i]->remaining = 0;
+        processes[i]->finished = true;
+        processes[i]->visited = true;
+    }
+
+    // rebuild RL in saved order
+    for (int i = 0; i < snapshot->num_ready; i++) {
+        Process* p = processes[snapshot->ready[i]];
+        p->remaining = snapshot->jobs[i * 2];
+        p->start = snapshot->jobs[i * 2 + 1];
+        p->finished = false;
+        if (!addNodeRR(rl, p)) {
+            return false;
+        }
+    }
+
+    // restore engine state
+    sim->time = snapshot->time;
+    sim->completed = snapshot->completed;
+    sim->next = snapshot->next;
+    sim->p = NULL;
+    sim->slice_start = snapshot->slice_start;
+    sim->slice_left = snapshot->slice_left;
+    if (snapshot->running != -1) {
+        sim->p = processes[snapshot->running];
+        sim->p->remaining = snapshot->jobs[snapshot->num_ready * 2];
+        sim->p->start = snapshot->jobs[snapshot->num_ready * 2 + 1];
+        sim->p->finished = false;
+    }
+
+    return true;
+}
+
+// free history memory
+void freeHistory(History* history) {
+    for (int i = 0; i < history->count; i++) {
+        free(history->snapshots[i].ready);
+        free(history->snapshots[i].jobs);
+    }
+    free(history->snapshots);
+    history->snapshots = NULL;
+    history->count = 0;
+    history->capacity = 0;
+    history->resume = NULL;
+}
+
+// GANTT FUNCTIONS
+
+// initialize an empty gantt timeline (false if out of memory)
+bool initGantt(Gantt* gantt, int capacity) {
+
+    // keep at least one slot so the timeline can grow by doubling
+    if (capacity < 1) {
+        capacity = 1;
+    }
+
+    gantt->pid = (int*) malloc(capacity * sizeof(int));
+    gantt->start = (int64_t*) malloc(capacity * sizeof(int64_t));
+    gantt->end = (int64_t*) malloc(capacity * sizeof(int64_t));
+    STAT_ADD(allocations, 3);
+    gantt->size = 0;
+    gantt->capacity = capacity;
+    gantt->trace = NULL;
+    gantt->cpu = 0;
+    gantt->discard = false;
+
+    // check if memory allocated properly
+    if (gantt->pid == NULL || gantt->start == NULL || gantt->end == NULL) {
+        freeGantt(gantt);
+        return false;
+    }
+
+    return true;
+}
+
+// add a slice (pid ran from start to end, idle pid = -1) to the timeline
+// (false if out of memory, timeline is left unchanged)
+bool addSlice(Gantt* gantt, int pid, int64_t start, int64_t end) {
+
+    // stream to the trace, which may be the only copy
+    if (gantt->trace != NULL) {
+        traceSlice(gantt->trace, gantt->cpu, pid, start, end);
+        if (gantt->discard) {
+            return true;
+        }
+    }
+
+    // grow timeline when full (each array is kept on failure, so it stays freeable)
+    if (gantt->size == gantt->capacity) {
+        int capacity = gantt->capacity * 2;
+        int* pids = (int*) realloc(gantt->pid, capacity * sizeof(int));
+        if (pids != NULL) {
+            gantt->pid = pids;
+        }
+        int64_t* starts = (int64_t*) realloc(gantt->start, capacity * sizeof(int64_t));
+        if (starts != NULL) {
+            gantt->start = starts;
+        }
+        int64_t* ends = (int64_t*) realloc(gantt->end, capacity * sizeof(int64_t));
+        if (ends != NULL) {
+            gantt->end = ends;
+        }
+        STAT_ADD(allocations, 3);
+
+        // check if memory allocated properly
+        if (pids == NULL || starts == NULL || ends == NULL) {
+            return false;
+        }
+        gantt->capacity = capacity;
+    }
+
+    gantt->pid[gantt->size] = pid;
+    gantt->start[gantt->size] = start;
+    gantt->end[gantt->size] = end;
+    gantt->size++;
+
+    return true;
+}
+
+// empty the timeline, keeping its memory for reuse
+void resetGantt(Gantt* gantt) {
+    gantt->size = 0;
+}
+
+// free gantt timeline memory
+void freeGantt(Gantt* gantt) {
+    free(gantt->pid);
+    free(gantt->start);
+    free(gantt->end);
+    gantt->pid = NULL;
+    gantt->start = NULL;
+    gantt->end = NULL;
+    gantt->size = 0;
+    gantt->capacity = 0;
+}
+
+// HELPER FUNCTION DEFINITIONS
+
+// helper to compare process arrival/pid for sorting
+int processDiff(const void *p1, const void *p2) {
+
+    // convert process ptrs to processes
+    Process* process1 = *(Process**)p1;
+    Process* process2 = *(Process**)p2;
+
+    // return pid order if arrival times are the same (compared, a difference
+    // of large or negative pids can overflow)
+    if (process1->arrival == process2->arrival) {
+        return (process1->pid > process2->pid) - (process1->pid < process2->pid);
+    }
+
+    // return the arrival time order btw processes (compared, 64-bit difference can overflow int)
+    return (process1->arrival > process2->arrival) - (process1->arrival < process2->arrival);
+}
+
+// helper to compare times for sorting
+int timeDiff(const void *t1, const void *t2) {
+    int64_t time1 = *(const int64_t*)t1;
+    int64_t time2 = *(const int64_t*)t2;
+    return (time1 > time2) - (time1 < time2);
+}
+
+// sort processes by arrival times then pid (asc) with an LSD radix sort,
+// skipping the sort if input is already ordered (false if out of memory)
+bool sortProcesses(Process** processes, int num_processes) {
+
+    // check if already sorted
+    int i = 1;
+    while (i < num_processes && processDiff(&processes[i - 1], &processes[i]) <= 0) {
+        i++;
+    }
+    if (i >= num_processes) {
+        return true;
+    }
+
+    // unsigned keys that order like the signed fields (flip sign bits)
+    typedef struct SortKey {
+        uint64_t arrival;
+        uint32_t pid;
+        Process* process;
+    } SortKey;
+
+    SortKey* keys = (SortKey*) malloc(num_processes * sizeof(SortKey));
+    SortKey* swap = (SortKey*) malloc(num_processes * sizeof(SortKey));
+
+    // 12 byte digits: 4 of pid (least significant) then 8 of arrival,
+    // count every digit's histogram in one pass
+    const int DIGITS = 12;
+    size_t (*counts)[256] = calloc(DIGITS, sizeof(*counts));
+    STAT_ADD(allocations, 3);
+    if (keys == NULL || swap == NULL || counts == NULL) {
+        free(keys);
+        free(swap);
+        free(counts);
+        return false;
+    }
+
+    for (i = 0; i < num_processes; i++) {
+        keys[i].arrival = (uint64_t) processes[i]->arrival ^ (1ULL << 63);
+        keys[i].pid = (uint32_t) processes[i]->pid ^ (1U << 31);
+        keys[i].process = processes[i];
+
+        for (int d = 0; d < 4; d++) {
+            counts[d][(keys[i].pid >> (8 * d)) & 0xFF]++;
+        }
+        for (int d = 0; d < 8; d++) {
+            counts[4 + d][(keys[i].arrival >> (8 * d)) & 0xFF]++;
+        }
+    }
+
+    // one stable counting pass per digit
+    for (int d = 0; d < DIGITS; d++) {
+
+        // skip digits every key shares
+        int shift = (d < 4) ? 8 * d : 8 * (d - 4);
+        uint64_t first = (d < 4) ? keys[0].pid : keys[0].arrival;
+        if (counts[d][(first >> shift) & 0xFF] == (size_t) num_processes) {
+            continue;
+        }
+
+        // bucket offsets
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t count = counts[d][b];
+            counts[d][b] = offset;
+            offset += count;
+        }
+
+        // scatter keys into buckets
+        for (i = 0; i < num_processes; i++) {
+            uint64_t key = (d < 4) ? keys[i].pid : keys[i].arrival;
+            swap[counts[d][(key >> shift) & 0xFF]++] = keys[i];
+        }
+
+        SortKey* tmp = keys;
+        keys = swap;
+        swap = tmp;
+    }
+
+    // write back sorted order
+    for (i = 0; i < num_processes; i++) {
+        processes[i] = keys[i].process;
+    }
+
+    free(keys);
+    free(swap);
+    free(counts);
+
+    return true;
+}
+
+// fill a process from an input line (pid,arrival,burst,priority,quantum);
+// returns false if the line doesn't hold all five fields
+bool parseProcess(const char* ln, Process* p) {
+
+    // create process object with line info
+    int fields = sscanf(ln, "%d,%" SCNd64 ",%" SCNd64 ",%d,%" SCNd64,
+        &(p->pid),
+        &(p->arrival),
+        &(p->burst),
+        &(p->priority),
+        &(p->quantum)
+    );
+
+    // set engineered process info
+    p->remaining = p->burst;
+    p->waiting = 0;
+    p->turnaround = 0;
+    p->start = 0;
+    p->complete = 0;
+    p->finished = false;
+    p->visited = false;
+
+    return fields == ARG_SIZE;
+}
+
+// check that a workload can run: no negative arrivals or bursts, and the clock
+// can't overflow (every process arriving last and running back to back)
+bool validWorkload(Process** processes, int num_processes) {
+
+    int64_t last_arrival = 0;
+    int64_t total_burst = 0;
+    for (int i = 0; i < num_processes; i++) {
+        if (processes[i]->arrival < 0 || processes[i]->burst < 0 || processes[i]->burst > INT64_MAX - total_burst) {
+            return false;
+        }
+        if (processes[i]->arrival > last_arrival) {
+            last_arrival = processes[i]->arrival;
+        }
+        total_burst += processes[i]->burst;
+    }
+
+    return total_burst <= INT64_MAX - last_arrival;
+}
+
+// find process object reference by pid (NULL if no process has it)
+Process* findProcess(Process** processes, int num_processes, int pid) {
+    for (int i = 0; i < num_processes; i++) {
+        if (processes[i]->pid == pid) {
+            return processes[i];
+        }
+    }
+
+    return NULL;
+}
+
+// xorshift64 random numbers (rng must start nonzero), used by the replicas
+// and the validation harness
+uint64_t nextRandom(uint64_t* rng) {
+    *rng ^= *rng << 13;
+    *rng ^= *rng >> 7;
+    *rng ^= *rng << 17;
+    return *rng;
+}
+
+// random integer in [lo, hi]
+int64_t randomRange(uint64_t* rng, int64_t lo, int64_t hi) {
+    return lo + (int64_t) (nextRandom(rng) % (uint64_t) (hi - lo + 1));
+}
+
+// READY LIST FUNCTIONS
+
+// initialize head of a new ready list (linked list)
+void initRL(RL* rl) {
+    rl->head = NULL;
+    rl->tail = NULL;
+    rl->size = 0;
+    rl->pool = NULL;
+    rl->pooled = 0;
+}
+
+// empty ready list, keeping its nodes pooled for the next run
+void clearRL(RL* rl) {
+    while (!isEmpty(rl)) {
+        removeNode(rl);
+    }
+}
+
+// free all nodes held by ready list (queued and pooled)
+void freeRL(RL* rl) {
+
+    clearRL(rl);
+
+    while (rl->pool != NULL) {
+        Node* node = rl->pool;
+        rl->pool = node->next;
+        free(node);
+    }
+    rl->pooled = 0;
+}
+
+// fill the pool with at least num_nodes nodes (false if out of memory)
+bool reserveNodes(RL* rl, int num_nodes) {
+
+    while (rl->pooled < num_nodes) {
+
+        // alloc mem for new node
+        Node* node = (Node*) malloc (sizeof(Node));
+        STAT_INC(allocations);
+
+        // check if memory allocated properly
+        if (node == NULL) {
+            return false;
+        }
+
+        releaseNode(rl, node);
+    }
+
+    return true;
+}
+
+// take a node from the pool, allocating one if the pool is empty (NULL if out of memory)
+Node* newNode(RL* rl) {
+
+    // reuse a released node
+    if (rl->pool != NULL) {
+        Node* node = rl->pool;
+        rl->pool = node->next;
+        rl->pooled--;
+        return node;
+    }
+
+    // alloc mem for new node
+    Node* node = (Node*) malloc (sizeof(Node));
+    STAT_INC(allocations);
+
+    return node;
+}
+
+// put a removed node in the pool
+void releaseNode(RL* rl, Node* node) {
+    node->next = rl->pool;
+    rl->pool = node;
+    rl->pooled++;
+}
+
+// add a node to the ready list (node->process), false if out of memory
+bool addNode(RL* rl, Process* p) {
+
+    // get a node (reused from pool when possible)
+    Node* node = newNode(rl);
+    if (node == NULL) {
+        return false;
+    }
+    STAT_INC(rl_inserts);
+
+    // set new node's info
+    node->process = p; // node->process is a pointer to a process
+    node->next = NULL;
+    rl->size++;
+
+    if (isEmpty(rl) || p->remaining < rl->head->process->remaining) {
+        node->next = rl->head;
+        rl->head = node;
+        if (rl->tail == NULL) {
+            rl->tail = node;
+        }
+    } else {
+
+        Node* curr = rl->head;
+
+        // find insert point (visited processes go straight to the end)
+        if (!p->visited) {
+            while (curr->next != NULL && curr->next->process->remaining < p->remaining) {
+                curr = curr->next;
+                STAT_INC(walk_steps);
+            }
+        } else {
+            curr = rl->tail;
+        }
+
+        // add node after insert point
+        node->next = curr->next;
+        curr->next = node;
+        if (curr == rl->tail) {
+            rl->tail = node;
+        }
+    }
+
+    return true;
+}
+
+// add a node to the ready list (node->process), false if out of memory
+bool addNodeRR(RL* rl, Process* p) {
+
+    // get a node (reused from pool when possible)
+    Node* node = newNode(rl);
+    if (node == NULL) {
+        return false;
+    }
+    STAT_INC(rl_inserts);
+
+    // set new node's info
+    node->process = p; // node->process is a pointer to a process
+    node->next = NULL;
+    rl->size++;
+
+    // add to head of list if list is empty, else after the tail
+    if (isEmpty(rl)) {
+        rl->head = node;
+    } else {
+        rl->tail->next = node;
+    }
+    rl->tail = node;
+
+    return true;
+}
+
+// check if ready list is empty
+int isEmpty(RL* rl) {
+
+    // return if ready list's head points to nothing
+    return (rl->head == NULL);
+}
+
+// remove node from ready list (FIFO), NULL if empty
+Process* removeNode(RL* rl) {
+    
+    // nothing to remove if RL is empty
+    if (isEmpty(rl)) {
+        return NULL;
+    }
+    STAT_INC(rl_removals);
+    rl->size--;
+
+    // get node to remove
+    Node* node = rl->head;
+
+    // set new head
+    rl->head = rl->head->next;
+    if (rl->head == NULL) {
+        rl->tail = NULL;
+    }
+
+    // save process associated with node
+    Process* p = node->process;
+
+    // return node to pool for reuse
+    releaseNode(rl, node);
+
+    // return process of deleted node
+    return p;
+}
+
+// remove node with the highest priority (lowest value) from ready list,
+// earliest added wins ties (NULL if empty)
+Process* removeNodePriority(RL* rl) {
+
+    // nothing to remove if RL is empty
+    if (isEmpty(rl)) {
+        return NULL;
+    }
+    STAT_INC(rl_removals);
+    rl->size--;
+
+    // find top priority node and the node before it (NULL = head)
+    Node* top = rl->head;
+    Node* prev_top = NULL;
+    for (Node* prev = rl->head; prev->next != NULL; prev = prev->next) {
+        if (prev->next->process->priority < top->process->priority) {
+            top = prev->next;
+            prev_top = prev;
+        }
+    }
+
+    // unlink top priority node
+    if (prev_top == NULL) {
+        rl->head = top->next;
+    } else {
+        prev_top->next = top->next;
+    }
+    if (rl->tail == top) {
+        rl->tail = prev_top;
+    }
+    Node* node = top;
+
+    // save process associated with node
+    Process* p = node->process;
+
+    // return node to pool for reuse
+    releaseNode(rl, node);
+
+    // return process of deleted node
+    return p;
+}
+
+// wipe time info for all processes
+void wipeProcessTimes(Process** processes, int num_processes) {
+
+    // reset all but pid, arrival, burst, priority, and quantum 
+    for (int i = 0; i < num_processes; i++) {
+        processes[i]->remaining = processes[i]->burst;
+        processes[i]->start = 0;
+        processes[i]->complete = 0;
+        processes[i]->finished = false;
+        processes[i]->visited = false;
+        processes[i]->cpu = -1;
+    }
+}
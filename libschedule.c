@@ -0,0 +1,654 @@
+#include "schedule.h"
+
+// caller-owned workload: processes plus the ready list kept warm between runs
+struct SchedWorkload {
+    Process* storage;       // process records (in insertion order)
+    Process** processes;    // pointers into storage, sorted before a run
+    int size;
+    int capacity;
+    bool sorted;            // processes is up to date and in arrival order
+    int snapshot_interval;  // runs keep a snapshot every so many admitted processes (0 = none)
+    RL rl;
+};
+
+// caller-owned results of one run (copied out, independent of the workload)
+struct SchedResult {
+    SchedJob* jobs;
+    int num_jobs;
+    Gantt gantt;
+    SchedSummary summary;
+    Policy policy;          // policy and quantum the run used
+    History history;        // snapshots for what-if runs
+    int* changed;           // what-if: indices of jobs that differ from the base run
+    int num_changed;
+};
+
+// WORKLOAD FUNCTIONS
+
+// create an empty workload
+SchedStatus schedCreateWorkload(SchedWorkload** workload) {
+
+    if (workload == NULL) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    SchedWorkload* w = (SchedWorkload*) calloc(1, sizeof(SchedWorkload));
+    if (w == NULL) {
+        return SCHED_ERR_MEMORY;
+    }
+    initRL(&w->rl);
+
+    *workload = w;
+
+    return SCHED_OK;
+}
+
+// take a slot for a new process, growing storage when full (NULL if out of memory)
+static Process* appendProcess(SchedWorkload* workload) {
+
+    // storage may move, so pointers are rebuilt before the next run (even if
+    // growing fails halfway)
+    workload->sorted = false;
+
+    if (workload->size == workload->capacity) {
+        int capacity = (workload->capacity == 0) ? 64 : workload->capacity * 2;
+
+        // pointers first: if storage can't grow they still point into it
+        Process** processes = (Process**) realloc(workload->processes, capacity * sizeof(Process*));
+        if (processes == NULL) {
+            return NULL;
+        }
+        workload->processes = processes;
+
+        Process* storage = (Process*) realloc(workload->storage, capacity * sizeof(Process));
+        if (storage == NULL) {
+            return NULL;
+        }
+        workload->storage = storage;
+        workload->capacity = capacity;
+    }
+
+    return &workload->storage[workload->size];
+}
+
+// add a process to the workload
+SchedStatus schedAddProcess(SchedWorkload* workload, int pid, int64_t arrival, int64_t burst, int priority, int64_t quantum) {
+
+    if (workload == NULL || arrival < 0 || burst < 0) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    Process* p = appendProcess(workload);
+    if (p == NULL) {
+        return SCHED_ERR_MEMORY;
+    }
+
+    memset(p, 0, sizeof(Process));
+    p->pid = pid;
+    p->arrival = arrival;
+    p->burst = burst;
+    p->priority = priority;
+    p->quantum = quantum;
+    p->remaining = burst;
+    workload->size++;
+
+    return SCHED_OK;
+}
+
+// add processes from input file text (pid,arrival,burst,priority,quantum per
+// line, blank lines skipped); on a bad line nothing is added
+SchedStatus schedParseWorkload(SchedWorkload* workload, const char* text, size_t length) {
+
+    if (workload == NULL || (text == NULL && length > 0)) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    int first = workload->size;
+    size_t i = 0;
+    while (i < length) {
+
+        // find end of line
+        size_t end = i;
+        while (end < length && text[end] != '\n') {
+            end++;
+        }
+
+        // copy line (trailing \r and blank lines skipped)
+        char ln[128];
+        size_t ln_length = end - i;
+        if (ln_length > 0 && text[end - 1] == '\r') {
+            ln_length--;
+        }
+        if (ln_length >= sizeof(ln)) {
+            workload->size = first;
+            return SCHED_ERR_PARSE;
+        }
+        memcpy(ln, text + i, ln_length);
+        ln[ln_length] = '\0';
+        i = end + 1;
+
+        if (ln_length == 0) {
+            continue;
+        }
+
+        // parse into a new slot
+        Process* p = appendProcess(workload);
+        if (p == NULL) {
+            workload->size = first;
+            return SCHED_ERR_MEMORY;
+        }
+        if (!parseProcess(ln, p) || p->arrival < 0 || p->burst < 0) {
+            workload->size = first;
+            return SCHED_ERR_PARSE;
+        }
+        workload->size++;
+    }
+
+    return SCHED_OK;
+}
+
+// keep an in-memory snapshot every interval admitted processes in later runs'
+// results, so what-if runs can start from them (0 = none)
+SchedStatus schedSetSnapshotInterval(SchedWorkload* workload, int interval) {
+
+    if (workload == NULL || interval < 0) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    workload->snapshot_interval = interval;
+
+    return SCHED_OK;
+}
+
+// number of processes in workload
+int schedWorkloadSize(const SchedWorkload* workload) {
+    return (workload == NULL) ? 0 : workload->size;
+}
+
+// free workload memory
+void schedFreeWorkload(SchedWorkload* workload) {
+
+    if (workload == NULL) {
+        return;
+    }
+
+    freeRL(&workload->rl);
+    free(workload->storage);
+    free(workload->processes);
+    free(workload);
+}
+
+// RUN FUNCTIONS
+
+// point and sort processes in arrival order (once until processes are added)
+static SchedStatus prepareWorkload(SchedWorkload* workload) {
+
+    if (workload->size == 0) {
+        return SCHED_ERR_EMPTY;
+    }
+    if (workload->sorted) {
+        return SCHED_OK;
+    }
+
+    for (int i = 0; i < workload->size; i++) {
+        workload->processes[i] = &workload->storage[i];
+    }
+    if (!sortProcesses(workload->processes, workload->size)) {
+        return SCHED_ERR_MEMORY;
+    }
+    workload->sorted = true;
+
+    return SCHED_OK;
+}
+
+// prepare a workload for a run, failing if the clock could overflow (arrivals
+// and bursts are checked for sign as they're added)
+static SchedStatus prepareRun(SchedWorkload* workload) {
+
+    SchedStatus status = prepareWorkload(workload);
+    if (status == SCHED_OK && !validWorkload(workload->processes, workload->size)) {
+        status = SCHED_ERR_ARGUMENT;
+    }
+
+    return status;
+}
+
+// allocate an empty result for a run of policy on the workload (NULL if out of memory)
+static SchedResult* newResult(SchedWorkload* workload, const Policy* policy) {
+
+    SchedResult* r = (SchedResult*) calloc(1, sizeof(SchedResult));
+    if (r == NULL) {
+        return NULL;
+    }
+    r->jobs = (SchedJob*) malloc(workload->size * sizeof(SchedJob));
+    r->changed = (int*) malloc(workload->size * sizeof(int));
+    if (r->jobs == NULL || r->changed == NULL || !initGantt(&r->gantt, workload->size * 2)) {
+        free(r->jobs);
+        free(r->changed);
+        free(r);
+        return NULL;
+    }
+    r->policy = *policy;
+    initHistory(&r->history, workload->snapshot_interval);
+
+    return r;
+}
+
+// copy out per-process results and overall stats of a finished run
+static void collectResult(SchedWorkload* workload, SchedResult* r, int64_t time) {
+
+    int num_processes = workload->size;
+    double total_waiting = 0.0;
+    double total_turnaround = 0.0;
+    for (int i = 0; i < num_processes; i++) {
+        Process* p = workload->processes[i];
+        SchedJob job = { p->pid, p->arrival, p->burst, p->priority, p->start, p->complete, p->waiting, p->turnaround };
+        r->jobs[i] = job;
+        total_waiting += p->waiting;
+        total_turnaround += p->turnaround;
+    }
+    r->num_jobs = num_processes;
+    r->summary.end_time = time;
+    r->summary.avg_waiting = total_waiting / num_processes;
+    r->summary.avg_turnaround = total_turnaround / num_processes;
+    r->summary.throughput = (double) num_processes / time;
+}
+
+// simulate a policy on the workload, results go to a new *result
+SchedStatus schedRunPolicy(SchedWorkload* workload, const char* policy_name, int64_t quantum, SchedResult** result) {
+
+    if (workload == NULL || policy_name == NULL || result == NULL) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    const Policy* found = findPolicy(policy_name);
+    if (found == NULL) {
+        return SCHED_ERR_POLICY;
+    }
+
+    SchedStatus status = prepareRun(workload);
+    if (status != SCHED_OK) {
+        return status;
+    }
+    int num_processes = workload->size;
+
+    // only round robin takes a quantum
+    Policy policy = *found;
+    if (strcmp(policy.name, "RR") == 0) {
+        if (quantum <= 0) {
+            quantum = workload->processes[0]->quantum;
+        }
+        if (quantum <= 0) {
+            return SCHED_ERR_QUANTUM;
+        }
+        policy.quantum = quantum;
+    }
+
+    // alloc mem for results
+    SchedResult* r = newResult(workload, &policy);
+    if (r == NULL) {
+        return SCHED_ERR_MEMORY;
+    }
+
+    // run the schedule
+    int64_t time;
+    status = simulateWith(&r->policy, &workload->rl, workload->processes, num_processes, &r->gantt, &time, \
+        NULL, NULL, NULL, &r->history, NULL);
+    if (status != SCHED_OK) {
+        schedFreeResult(r);
+        return status;
+    }
+    collectResult(workload, r, time);
+
+    *result = r;
+
+    return SCHED_OK;
+}
+
+// search for the round robin quantum with the lowest cost
+SchedStatus schedTuneQuantum(SchedWorkload* workload, SchedObjective objective, double switch_weight, \
+    int64_t* quantum, double* cost) {
+
+    if (workload == NULL || quantum == NULL || cost == NULL || \
+    (objective != SCHED_OBJECTIVE_AVG_WAITING && objective != SCHED_OBJECTIVE_P99_WAITING)) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    SchedStatus status = prepareRun(workload);
+    if (status != SCHED_OK) {
+        return status;
+    }
+
+    Tuning tuning = { objective, switch_weight, 0, 0.0, 0, 0 };
+    status = tuneQuantum(&workload->rl, workload->processes, workload->size, &tuning);
+    if (status != SCHED_OK) {
+        return status;
+    }
+
+    *quantum = tuning.quantum;
+    *cost = tuning.cost;
+
+    return SCHED_OK;
+}
+
+// WHAT-IF FUNCTIONS
+
+// apply an edit to a prepared workload, keeping it in arrival order where it
+// can; sets the edited process's position in arrival order (before a removal)
+// and its arrival time
+static SchedStatus applyEdit(SchedWorkload* workload, const SchedEdit* edit, int* index, int64_t* arrival) {
+
+    // every edit but an insert needs the process, an insert needs a new pid
+    int found = -1;
+    for (int i = 0; i < workload->size; i++) {
+        if (workload->processes[i]->pid == edit->pid) {
+            found = i;
+            break;
+        }
+    }
+    if ((edit->kind == SCHED_EDIT_INSERT) != (found == -1)) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    switch (edit->kind) {
+
+        // (the old burst stays if the new one is negative or could overflow the clock)
+        case SCHED_EDIT_BURST: {
+            Process* p = workload->processes[found];
+            int64_t burst = p->burst;
+            p->burst = edit->burst;
+            if (edit->burst < 0 || !validWorkload(workload->processes, workload->size)) {
+                p->burst = burst;
+                return SCHED_ERR_ARGUMENT;
+            }
+            break;
+        }
+
+        case SCHED_EDIT_PRIORITY:
+            workload->processes[found]->priority = edit->priority;
+            break;
+
+        case SCHED_EDIT_REMOVE: {
+            Process* p = workload->processes[found];
+            *arrival = p->arrival;
+            int size = workload->size;
+
+            // close the gap in arrival order
+            memmove(&workload->processes[found], &workload->processes[found + 1], (size - found - 1) * sizeof(Process*));
+
+            // move the last record into the freed slot so storage stays packed
+            Process* last = &workload->storage[size - 1];
+            if (p != last) {
+                *p = *last;
+                for (int i = 0; i < size - 1; i++) {
+                    if (workload->processes[i] == last) {
+                        workload->processes[i] = p;
+                        break;
+                    }
+                }
+            }
+            workload->size--;
+
+            *index = found;
+            return SCHED_OK;
+        }
+
+        case SCHED_EDIT_INSERT: {
+            Process* storage = workload->storage;
+            SchedStatus status = schedAddProcess(workload, edit->pid, edit->arrival, edit->burst, edit->priority, edit->quantum);
+            if (status != SCHED_OK) {
+                return status;
+            }
+            Process* p = &workload->storage[workload->size - 1];
+
+            // storage didn't move: binary search its place instead of sorting again
+            if (workload->storage == storage) {
+                int low = 0;
+                int high = workload->size - 1;
+                while (low < high) {
+                    int mid = low + (high - low) / 2;
+                    if (processDiff(&workload->processes[mid], &p) > 0) {
+                        high = mid;
+                    } else {
+                        low = mid + 1;
+                    }
+                }
+                memmove(&workload->processes[low + 1], &workload->processes[low], \
+                    (workload->size - 1 - low) * sizeof(Process*));
+                workload->processes[low] = p;
+                workload->sorted = true;
+                found = low;
+            } else {
+                status = prepareWorkload(workload);
+                if (status != SCHED_OK) {
+                    return status;
+                }
+                found = 0;
+                while (workload->processes[found] != p) {
+                    found++;
+                }
+            }
+
+            // dropped again if the clock could overflow (p is the last record)
+            if (!validWorkload(workload->processes, workload->size)) {
+                memmove(&workload->processes[found], &workload->processes[found + 1], \
+                    (workload->size - found - 1) * sizeof(Process*));
+                workload->size--;
+                return SCHED_ERR_ARGUMENT;
+            }
+            break;
+        }
+
+        default:
+            return SCHED_ERR_ARGUMENT;
+    }
+
+    *index = found;
+    *arrival = workload->processes[found]->arrival;
+
+    return SCHED_OK;
+}
+
+// apply an edit to the workload base was last run on, then re-simulate base's
+// policy from its latest snapshot before the edited process arrives (nothing
+// before that depends on the process); the new *result lists the jobs that
+// differ from base and delta the change in overall stats
+SchedStatus schedWhatIf(SchedWorkload* workload, const SchedResult* base, const SchedEdit* edit, \
+    SchedResult** result, SchedDelta* delta) {
+
+    if (workload == NULL || base == NULL || edit == NULL || result == NULL || delta == NULL || \
+    base->num_jobs != workload->size) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    SchedStatus status = prepareRun(workload);
+    if (status != SCHED_OK) {
+        return status;
+    }
+
+    // edit the workload
+    int index;
+    int64_t arrival;
+    status = applyEdit(workload, edit, &index, &arrival);
+    if (status == SCHED_OK) {
+        status = prepareWorkload(workload);
+    }
+    if (status != SCHED_OK) {
+        return status;
+    }
+    int num_processes = workload->size;
+    Process** processes = workload->processes;
+
+    // alloc mem for results
+    SchedResult* r = newResult(workload, &base->policy);
+    if (r == NULL) {
+        return SCHED_ERR_MEMORY;
+    }
+
+    // keep base's snapshots from before the arrival (for later what-if runs too)
+    for (int k = 0; k < base->history.count && base->history.snapshots[k].time < arrival; k++) {
+        if (!copySnapshot(&r->history, &base->history.snapshots[k])) {
+            schedFreeResult(r);
+            return SCHED_ERR_MEMORY;
+        }
+    }
+
+    // processes finished and slices added before the latest of them keep base's results
+    Snapshot* snapshot = NULL;
+    if (r->history.count > 0) {
+        snapshot = &r->history.snapshots[r->history.count - 1];
+        for (int i = 0; i < snapshot->next; i++) {
+            processes[i]->start = base->jobs[i].start;
+            processes[i]->complete = base->jobs[i].complete;
+            processes[i]->waiting = base->jobs[i].waiting;
+            processes[i]->turnaround = base->jobs[i].turnaround;
+        }
+        for (int i = 0; i < snapshot->num_slices; i++) {
+            if (!addSlice(&r->gantt, base->gantt.pid[i], base->gantt.start[i], base->gantt.end[i])) {
+                schedFreeResult(r);
+                return SCHED_ERR_MEMORY;
+            }
+        }
+    }
+
+    // run the rest of the schedule (snapshots taken may move the history)
+    int64_t time;
+    int64_t resumed_at = (snapshot != NULL) ? snapshot->time : 0;
+    r->history.resume = snapshot;
+    status = simulateWith(&r->policy, &workload->rl, processes, num_processes, &r->gantt, &time, \
+        NULL, NULL, NULL, &r->history, NULL);
+    r->history.resume = NULL;
+    if (status != SCHED_OK) {
+        schedFreeResult(r);
+        return status;
+    }
+    collectResult(workload, r, time);
+
+    // jobs that differ from base (positions past an insert/removal are shifted by one)
+    for (int i = 0; i < num_processes; i++) {
+        int b = i;
+        if (edit->kind == SCHED_EDIT_INSERT && i >= index) {
+            b = i - 1;
+        } else if (edit->kind == SCHED_EDIT_REMOVE && i >= index) {
+            b = i + 1;
+        }
+
+        bool edited = (i == index && edit->kind != SCHED_EDIT_REMOVE);
+        if (edited || r->jobs[i].start != base->jobs[b].start || r->jobs[i].complete != base->jobs[b].complete) {
+            r->changed[r->num_changed++] = i;
+        }
+    }
+
+    // change in overall stats
+    delta->resumed_at = resumed_at;
+    delta->changed_jobs = r->num_changed;
+    delta->end_time = r->summary.end_time - base->summary.end_time;
+    delta->avg_waiting = r->summary.avg_waiting - base->summary.avg_waiting;
+    delta->avg_turnaround = r->summary.avg_turnaround - base->summary.avg_turnaround;
+    delta->throughput = r->summary.throughput - base->summary.throughput;
+
+    *result = r;
+
+    return SCHED_OK;
+}
+
+// RESULT FUNCTIONS
+
+// number of jobs in result
+int schedResultJobs(const SchedResult* result) {
+    return (result == NULL) ? 0 : result->num_jobs;
+}
+
+// copy the i-th job (arrival order) of a result
+SchedStatus schedResultJob(const SchedResult* result, int i, SchedJob* job) {
+
+    if (result == NULL || job == NULL || i < 0 || i >= result->num_jobs) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    *job = result->jobs[i];
+
+    return SCHED_OK;
+}
+
+// number of gantt slices in result
+int schedResultSlices(const SchedResult* result) {
+    return (result == NULL) ? 0 : result->gantt.size;
+}
+
+// copy the i-th gantt slice of a result
+SchedStatus schedResultSlice(const SchedResult* result, int i, SchedSlice* slice) {
+
+    if (result == NULL || slice == NULL || i < 0 || i >= result->gantt.size) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    slice->pid = result->gantt.pid[i];
+    slice->start = result->gantt.start[i];
+    slice->end = result->gantt.end[i];
+
+    return SCHED_OK;
+}
+
+// number of jobs that differ from a what-if result's base
+int schedChangedJobs(const SchedResult* result) {
+    return (result == NULL) ? 0 : result->num_changed;
+}
+
+// copy the i-th job (arrival order) that differs from a what-if result's base
+SchedStatus schedChangedJob(const SchedResult* result, int i, SchedJob* job) {
+
+    if (result == NULL || job == NULL || i < 0 || i >= result->num_changed) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    *job = result->jobs[result->changed[i]];
+
+    return SCHED_OK;
+}
+
+// copy the overall stats of a result
+SchedStatus schedResultSummary(const SchedResult* result, SchedSummary* summary) {
+
+    if (result == NULL || summary == NULL) {
+        return SCHED_ERR_ARGUMENT;
+    }
+
+    *summary = result->summary;
+
+    return SCHED_OK;
+}
+
+// free result memory
+void schedFreeResult(SchedResult* result) {
+
+    if (result == NULL) {
+        return;
+    }
+
+    freeGantt(&result->gantt);
+    freeHistory(&result->history);
+    free(result->jobs);
+    free(result->changed);
+    free(result);
+}
+
+// describe a status code
+const char* schedStatusMessage(SchedStatus status) {
+
+    switch (status) {
+        case SCHED_OK: return "success";
+        case SCHED_ERR_MEMORY: return "allocating memory";
+        case SCHED_ERR_ARGUMENT: return "invalid argument";
+        case SCHED_ERR_PARSE: return "parsing process line";
+        case SCHED_ERR_EMPTY: return "no processes";
+        case SCHED_ERR_POLICY: return "unknown policy";
+        case SCHED_ERR_QUANTUM: return "invalid quantum";
+        case SCHED_ERR_CHECKPOINT_IO: return "reading/writing checkpoint file";
+        case SCHED_ERR_CHECKPOINT_INVALID: return "invalid checkpoint file";
+        case SCHED_ERR_CHECKPOINT_MISMATCH: return "checkpoint does not match input";
+        case SCHED_ERR_UNSORTED: return "arrivals out of order";
+    }
+
+    return "unknown error";
+}
@@ -0,0 +1,143 @@
+#ifndef LIBSCHEDULE_H
+#define LIBSCHEDULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// embeddable scheduler simulations (libschedule.a / libschedule.so)
+//
+// all state lives in caller-owned workloads and results, nothing is printed
+// and errors come back as status codes, so any number of simulations can run
+// in one process (a workload or result is used by one thread at a time)
+//
+//     SchedWorkload* workload;
+//     SchedResult* result;
+//     schedCreateWorkload(&workload);
+//     schedParseWorkload(workload, text, length);
+//     schedRunPolicy(workload, "rr", 0, &result);
+//     ... schedResultJob(result, i, &job) ...
+//     schedFreeResult(result);
+//     schedFreeWorkload(workload);
+
+// public api (libschedule.so is built with every other symbol hidden)
+#if defined(__GNUC__)
+#define SCHED_API __attribute__((visibility("default")))
+#else
+#define SCHED_API
+#endif
+
+// status codes (SCHED_OK = success)
+typedef enum SchedStatus {
+    SCHED_OK = 0,
+    SCHED_ERR_MEMORY,               // allocation failed
+    SCHED_ERR_ARGUMENT,             // NULL context, index out of range, or negative/overflowing arrival or burst
+    SCHED_ERR_PARSE,                // input line isn't pid,arrival,burst,priority,quantum (arrival, burst >= 0)
+    SCHED_ERR_EMPTY,                // workload has no processes
+    SCHED_ERR_POLICY,               // unknown policy name
+    SCHED_ERR_QUANTUM,              // round robin quantum <= 0
+    SCHED_ERR_CHECKPOINT_IO,        // checkpoint file couldn't be read/written
+    SCHED_ERR_CHECKPOINT_INVALID,   // checkpoint file is corrupt or a different version
+    SCHED_ERR_CHECKPOINT_MISMATCH,  // checkpoint was taken from another input/policy
+    SCHED_ERR_UNSORTED,             // streamed arrivals weren't in arrival/pid order
+} SchedStatus;
+
+// quantum tuning objectives (each plus a cost per context switch)
+typedef enum SchedObjective {
+    SCHED_OBJECTIVE_AVG_WAITING,
+    SCHED_OBJECTIVE_P99_WAITING,
+} SchedObjective;
+
+// per-process results
+typedef struct SchedJob {
+    int pid;
+    int64_t arrival;
+    int64_t burst;
+    int priority;
+    int64_t start;          // first dispatch
+    int64_t complete;
+    int64_t waiting;
+    int64_t turnaround;
+} SchedJob;
+
+// gantt slice (idle = pid -1)
+typedef struct SchedSlice {
+    int pid;
+    int64_t start;
+    int64_t end;
+} SchedSlice;
+
+// overall schedule stats
+typedef struct SchedSummary {
+    int64_t end_time;
+    double avg_waiting;
+    double avg_turnaround;
+    double throughput;
+} SchedSummary;
+
+// workload edits for what-if runs
+typedef enum SchedEditKind {
+    SCHED_EDIT_INSERT,      // add a process (pid must be new)
+    SCHED_EDIT_REMOVE,      // remove process pid
+    SCHED_EDIT_BURST,       // set process pid's burst
+    SCHED_EDIT_PRIORITY,    // set process pid's priority
+} SchedEditKind;
+
+typedef struct SchedEdit {
+    SchedEditKind kind;
+    int pid;
+    int64_t arrival;        // insert
+    int64_t burst;          // insert, burst
+    int priority;           // insert, priority
+    int64_t quantum;        // insert
+} SchedEdit;
+
+// what-if result minus its base
+typedef struct SchedDelta {
+    int64_t resumed_at;     // time re-simulation started from (0 = from scratch)
+    int changed_jobs;       // jobs with a different start/completion (plus an inserted/edited job)
+    int64_t end_time;
+    double avg_waiting;
+    double avg_turnaround;
+    double throughput;
+} SchedDelta;
+
+typedef struct SchedWorkload SchedWorkload;
+typedef struct SchedResult SchedResult;
+
+// WORKLOADS
+SCHED_API SchedStatus schedCreateWorkload(SchedWorkload** workload);
+SCHED_API SchedStatus schedAddProcess(SchedWorkload* workload, int pid, int64_t arrival, int64_t burst, int priority, int64_t quantum);
+SCHED_API SchedStatus schedParseWorkload(SchedWorkload* workload, const char* text, size_t length);
+SCHED_API SchedStatus schedSetSnapshotInterval(SchedWorkload* workload, int interval);
+SCHED_API int schedWorkloadSize(const SchedWorkload* workload);
+SCHED_API void schedFreeWorkload(SchedWorkload* workload);
+
+// RUNS (policy = fcfs/sjf/ps/rr; rr uses each process's own quantum if > 0, else
+// quantum, where quantum <= 0 = earliest arrival's quantum)
+SCHED_API SchedStatus schedRunPolicy(SchedWorkload* workload, const char* policy, int64_t quantum, SchedResult** result);
+
+// best round robin quantum (one for every process) for an objective, where each
+// context switch adds switch_weight / number of processes to the cost
+SCHED_API SchedStatus schedTuneQuantum(SchedWorkload* workload, SchedObjective objective, double switch_weight, \
+    int64_t* quantum, double* cost);
+
+// WHAT-IF (edit the workload base was last run on and re-simulate base's
+// policy/quantum from the latest snapshot before the edit matters; runs keep
+// snapshots every interval admitted processes set with schedSetSnapshotInterval,
+// without any the run starts from scratch; what-if results can be bases too)
+SCHED_API SchedStatus schedWhatIf(SchedWorkload* workload, const SchedResult* base, const SchedEdit* edit, \
+    SchedResult** result, SchedDelta* delta);
+
+// RESULTS (jobs in arrival order)
+SCHED_API int schedResultJobs(const SchedResult* result);
+SCHED_API SchedStatus schedResultJob(const SchedResult* result, int i, SchedJob* job);
+SCHED_API int schedResultSlices(const SchedResult* result);
+SCHED_API SchedStatus schedResultSlice(const SchedResult* result, int i, SchedSlice* slice);
+SCHED_API SchedStatus schedResultSummary(const SchedResult* result, SchedSummary* summary);
+SCHED_API int schedChangedJobs(const SchedResult* result);
+SCHED_API SchedStatus schedChangedJob(const SchedResult* result, int i, SchedJob* job);
+SCHED_API void schedFreeResult(SchedResult* result);
+
+SCHED_API const char* schedStatusMessage(SchedStatus status);
+
+#endif
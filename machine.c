@@ -0,0 +1,254 @@
+#include "schedule.h"
+
+// multi-cpu simulation with a cache affinity cost model: every process
+// remembers the cpu it last ran on, and when it's dispatched again the cpu
+// stalls before the process makes progress
+//
+//   - on another cpu (migration): machine->migration_cost
+//   - on the same cpu after another process ran there (cold restart): machine->cold_cost
+//
+// a process's first dispatch and a resume on a still-warm cpu are free;
+// penalty time counts towards waiting (turnaround - burst) but not towards
+// a round robin quantum, and a preempted stall is cut short
+//
+// dispatching, finishing and requeueing a process are the engine's steps (see
+// dispatchNext), only the cpu bookkeeping and the penalties live here
+
+// run processes (sorted by arrival/pid) under a policy on machine's cpus, cpu c
+// adding slices to gantts[c]; sets end_time and machine's migration stats
+SchedStatus simulateCpus(const Policy* policy, RL* rl, Process** processes, int num_processes, Gantt* gantts, \
+    int64_t* end_time, Machine* machine) {
+
+    PHASE_BEGIN(PHASE_SIMULATE);
+
+    // reset all process fields to default (processes are already sorted by arrival)
+    wipeProcessTimes(processes, num_processes);
+    for (int i = 0; i < num_processes; i++) {
+        processes[i]->index = i;
+    }
+    machine->migrations = 0;
+    machine->cold_restarts = 0;
+    machine->penalty = 0;
+
+    // RL never holds more than every process, so it can't run out of nodes mid-run
+    if (!reserveNodes(rl, num_processes)) {
+        PHASE_END(PHASE_SIMULATE);
+        return SCHED_ERR_MEMORY;
+    }
+
+    // event queue: an arrival timer per process not yet admitted, plus each
+    // busy cpu's completion/quantum expiry timer
+    int num_cpus = machine->num_cpus;
+    Wheel* wheel = (Wheel*) malloc(sizeof(Wheel));
+    Timer* arrivals = (Timer*) calloc(num_processes + 1, sizeof(Timer));
+    Cpu* cpus = (Cpu*) calloc(num_cpus, sizeof(Cpu));
+    STAT_ADD(allocations, 3);
+    if (wheel == NULL || arrivals == NULL || cpus == NULL) {
+        free(wheel);
+        free(arrivals);
+        free(cpus);
+        PHASE_END(PHASE_SIMULATE);
+        return SCHED_ERR_MEMORY;
+    }
+    initWheel(wheel, 0);
+    for (int i = 0; i < num_processes; i++) {
+        arrivals[i].data = processes[i];
+        addTimer(wheel, &arrivals[i], processes[i]->arrival);
+    }
+
+    // variables to manage processes and time
+    int64_t time = 0;
+    int completed = 0;
+    int next = 0;       // index of next process to arrive
+    int busy = 0;       // cpus running a process
+    SchedStatus status = SCHED_OK;
+
+    // loop until all processes are done
+    while (completed < num_processes) {
+
+        STAT_INC(events);
+
+        // add processes that have arrived to RL
+        admitArrivals(policy, rl, wheel, &next, time);
+
+        // dispatch ready processes to free cpus
+        while (busy < num_cpus && !isEmpty(rl)) {
+
+            int64_t slice_left;
+            Process* p = dispatchNext(policy, rl, time, &slice_left);
+            int c = pickCpu(machine, cpus, p);
+            Cpu* cpu = &cpus[c];
+
+            // close the cpu's idle stretch
+            if (cpu->free_since < time && !addSlice(&gantts[c], -1, cpu->free_since, time)) {
+                status = SCHED_ERR_MEMORY;
+                break;
+            }
+
+            cpu->stall = dispatchPenalty(machine, cpus, c, p);
+            if (cpu->stall > 0 && gantts[c].trace != NULL) {
+                traceMark(gantts[c].trace, c, (p->cpu == c) ? "cold restart" : "migrated", p->pid, time);
+            }
+
+            cpu->p = p;
+            cpu->last = p;
+            p->cpu = c;
+            cpu->slice_start = time;
+            cpu->slice_left = slice_left;
+            busy++;
+
+            // time completion or quantum expiry (after the stall)
+            addTimer(wheel, &cpu->timer, runEnd(policy, p, cpu->slice_left, time + cpu->stall));
+        }
+        if (status != SCHED_OK) {
+            break;
+        }
+
+        // nothing running or ready, idle until the next arrival
+        if (busy == 0) {
+            time = nextTimer(wheel);
+            continue;
+        }
+
+        // run every busy cpu until the next event: an arrival, or a
+        // completion/quantum expiry on any cpu
+        int64_t event = nextTimer(wheel);
+        int64_t run = event - time;
+        for (int c = 0; c < num_cpus; c++) {
+            Cpu* cpu = &cpus[c];
+            if (cpu->p == NULL) {
+                continue;
+            }
+
+            // penalty first, then progress
+            int64_t stalled = (cpu->stall < run) ? cpu->stall : run;
+            cpu->stall -= stalled;
+            machine->penalty += stalled;
+            cpu->p->remaining -= run - stalled;
+            cpu->slice_left -= run - stalled;
+
+            // run ends on completion or quantum expiry (arrivals may be admitted
+            // below, so no run timer can be left behind)
+            if (cpu->timer.expires == event && isPending(&cpu->timer)) {
+                cancelTimer(wheel, &cpu->timer);
+            }
+        }
+        time = event;
+
+        // finish runs that ended
+        for (int c = 0; c < num_cpus && status == SCHED_OK; c++) {
+            Cpu* cpu = &cpus[c];
+            Process* p = cpu->p;
+            if (p == NULL || isPending(&cpu->timer)) {
+                continue;
+            }
+
+            // process is done, or its quantum is used up
+            bool ok;
+            if (p->remaining == 0) {
+                completed++;
+                ok = finishProcess(&gantts[c], p, cpu->slice_start, time);
+            } else {
+                ok = expireQuantum(policy, rl, wheel, &next, &gantts[c], p, cpu->slice_start, time);
+            }
+
+            cpu->p = NULL;
+            cpu->free_since = time;
+            busy--;
+            if (!ok) {
+                status = SCHED_ERR_MEMORY;
+            }
+        }
+        if (status != SCHED_OK) {
+            break;
+        }
+
+        // arrivals preempt processes they beat, once free cpus are taken
+        // (each preempts the cpu whose process every other candidate beats)
+        if (policy->preempt != NULL) {
+
+            int free_cpus = num_cpus - busy;
+            for (int i = next; i < num_processes && processes[i]->arrival <= time; i++) {
+
+                if (free_cpus > 0) {
+                    free_cpus--;
+                    continue;
+                }
+
+                int victim = -1;
+                for (int c = 0; c < num_cpus; c++) {
+                    Process* p = cpus[c].p;
+                    if (p != NULL && policy->preempt(p, processes[i]) && \
+                    (victim == -1 || policy->preempt(p, cpus[victim].p))) {
+                        victim = c;
+                    }
+                }
+                if (victim == -1) {
+                    continue;
+                }
+
+                Cpu* cpu = &cpus[victim];
+                Process* p = cpu->p;
+                cpu->p = NULL;
+                cpu->free_since = time;
+                busy--;
+                if (!preemptProcess(policy, rl, wheel, &cpu->timer, &gantts[victim], p, cpu->slice_start, time)) {
+                    status = SCHED_ERR_MEMORY;
+                    break;
+                }
+            }
+            if (status != SCHED_OK) {
+                break;
+            }
+        }
+    }
+
+    free(wheel);
+    free(arrivals);
+    free(cpus);
+
+    // leave RL empty for the next run
+    clearRL(rl);
+
+    *end_time = time;
+
+    PHASE_END(PHASE_SIMULATE);
+
+    return status;
+}
+
+// free cpu to run p on: its last cpu with affinity, else the first free one
+int pickCpu(Machine* machine, Cpu* cpus, Process* p) {
+
+    if (machine->affinity && p->cpu != -1 && cpus[p->cpu].p == NULL) {
+        return p->cpu;
+    }
+
+    int c = 0;
+    while (cpus[c].p != NULL) {
+        c++;
+    }
+
+    return c;
+}
+
+// penalty for dispatching p on cpu c, counted in machine's stats (penalty
+// time itself is counted as it's served, a preemption can cut it short)
+int64_t dispatchPenalty(Machine* machine, Cpu* cpus, int c, Process* p) {
+
+    // first run, or cache still warm
+    if (p->cpu == -1 || (p->cpu == c && cpus[c].last == p)) {
+        return 0;
+    }
+
+    int64_t penalty;
+    if (p->cpu != c) {
+        machine->migrations++;
+        penalty = machine->migration_cost;
+    } else {
+        machine->cold_restarts++;
+        penalty = machine->cold_cost;
+    }
+
+    return penalty;
+}
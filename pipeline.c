@@ -0,0 +1,103 @@
+#include <sched.h>
+#include "schedule.h"
+
+// pipelined loading: a parser thread fills preallocated process slots in file
+// order and publishes each batch's end index through a lock-free
+// single-producer/single-consumer ring, so the simulator can start on the
+// first batch while the rest of the file is still being parsed
+//
+// head (batches published) is only written by the parser and tail (batches
+// taken) only by the simulator; release stores / acquire loads make a
+// batch's processes visible before its end index
+
+// FUNCTION PROTOTYPES
+void* parseLoop(void* arg);
+void publishBatch(ArrivalSource* source, int end);
+
+// start parsing num_processes lines of file into processes on a new thread
+// (false if the thread couldn't be started)
+bool startSource(ArrivalSource* source, FILE* file, Process** processes, int num_processes) {
+
+    memset(source, 0, sizeof(ArrivalSource));
+    source->processes = processes;
+    source->num_processes = num_processes;
+    source->file = file;
+
+    return pthread_create(&source->thread, NULL, parseLoop, source) == 0;
+}
+
+// parser thread: parse lines, publishing every SOURCE_BATCH processes
+void* parseLoop(void* arg) {
+
+    ArrivalSource* source = (ArrivalSource*) arg;
+    Process** processes = source->processes;
+    char ln[128];   // fits five 64-bit fields
+
+    int j = 0;
+    while (j < source->num_processes && fgets(ln, sizeof(ln), source->file)) {
+
+        // create process object with line info
+        parseProcess(ln, processes[j]);
+
+        // the simulator relies on arrival/pid order (flag is published with the batch)
+        if (j > 0 && processDiff(&processes[j - 1], &processes[j]) > 0) {
+            __atomic_store_n(&source->unsorted, true, __ATOMIC_RELAXED);
+        }
+
+        j++;
+        if (j % SOURCE_BATCH == 0) {
+            publishBatch(source, j);
+        }
+    }
+
+    // publish the last partial batch
+    if (j % SOURCE_BATCH != 0 || j == 0) {
+        publishBatch(source, j);
+    }
+    __atomic_store_n(&source->parsed, true, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+// push a batch (processes up to end) into the ring, waiting while it's full
+void publishBatch(ArrivalSource* source, int end) {
+
+    unsigned head = source->head;
+    while (head - __atomic_load_n(&source->tail, __ATOMIC_ACQUIRE) == SOURCE_RING_SIZE) {
+        sched_yield();
+    }
+
+    source->ends[head % SOURCE_RING_SIZE] = end;
+    __atomic_store_n(&source->head, head + 1, __ATOMIC_RELEASE);
+}
+
+// take the next batch from the ring, waiting while it's empty; returns the
+// new number of parsed processes
+int nextBatch(ArrivalSource* source) {
+
+    unsigned tail = source->tail;
+    while (__atomic_load_n(&source->head, __ATOMIC_ACQUIRE) == tail) {
+        sched_yield();
+    }
+
+    int end = source->ends[tail % SOURCE_RING_SIZE];
+    __atomic_store_n(&source->tail, tail + 1, __ATOMIC_RELEASE);
+
+    return end;
+}
+
+// wait for the parser thread to finish, dropping batches the simulator didn't
+// take (a run that stops early, e.g. on unsorted input, would otherwise leave
+// the parser waiting on a full ring)
+void finishSource(ArrivalSource* source) {
+
+    while (!__atomic_load_n(&source->parsed, __ATOMIC_ACQUIRE)) {
+        if (__atomic_load_n(&source->head, __ATOMIC_ACQUIRE) != source->tail) {
+            nextBatch(source);
+        } else {
+            sched_yield();
+        }
+    }
+
+    pthread_join(source->thread, NULL);
+}
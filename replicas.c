@@ -0,0 +1,255 @@
+#include <pthread.h>
+#include <unistd.h>
+#include <math.h>
+#include "schedule.h"
+
+// monte carlo replicas: each replica perturbs the workload (arrivals jittered
+// by up to +/- jitter, bursts resampled from the original bursts with
+// replacement) and runs every selected policy; replicas are seeded by index,
+// so results don't depend on the number of threads
+
+// two-sided 95% student's t critical values by degrees of freedom (1-30)
+static const double T_95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+
+// replica worker thread arguments
+typedef struct ReplicaWorker {
+    pthread_t thread;
+    Replicas* replicas;
+    Process** source;       // original workload
+    int num_processes;
+    int first;              // first replica (then every stride-th)
+    int stride;
+    SchedStatus status;
+} ReplicaWorker;
+
+// FUNCTION PROTOTYPES
+void* replicaLoop(void* arg);
+
+// run replicas->count perturbed replicas of processes on num_threads threads,
+// filling replicas->samples
+SchedStatus runReplicas(Process** processes, int num_processes, Replicas* replicas) {
+
+    if (num_processes == 0 || replicas->count <= 0) {
+        return SCHED_ERR_EMPTY;
+    }
+
+    // round robin needs a quantum for processes without their own
+    int rr = (int) (findPolicy("RR") - POLICIES);
+    if ((replicas->policies & (1U << rr)) && replicas->quantum <= 0) {
+        return SCHED_ERR_QUANTUM;
+    }
+
+    // default to one thread per cpu (never more than replicas)
+    int num_threads = replicas->num_threads;
+    if (num_threads <= 0) {
+        num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_threads <= 0) {
+        num_threads = 1;
+    }
+    if (num_threads > replicas->count) {
+        num_threads = replicas->count;
+    }
+    replicas->num_threads = num_threads;
+
+    // samples for every replica, policy and metric
+    replicas->samples = (double*) calloc((size_t) replicas->count * NUM_POLICIES * NUM_REPLICA_METRICS, sizeof(double));
+    ReplicaWorker* workers = (ReplicaWorker*) malloc(num_threads * sizeof(ReplicaWorker));
+    if (replicas->samples == NULL || workers == NULL) {
+        free(workers);
+        return SCHED_ERR_MEMORY;
+    }
+
+    // start workers, each taking every num_threads-th replica
+    int started = 0;
+    SchedStatus status = SCHED_OK;
+    for (int t = 0; t < num_threads; t++) {
+        ReplicaWorker worker = { 0, replicas, processes, num_processes, t, num_threads, SCHED_OK };
+        workers[t] = worker;
+        if (pthread_create(&workers[t].thread, NULL, replicaLoop, &workers[t]) != 0) {
+            status = SCHED_ERR_MEMORY;
+            break;
+        }
+        started++;
+    }
+
+    // wait for workers
+    for (int t = 0; t < started; t++) {
+        pthread_join(workers[t].thread, NULL);
+        if (status == SCHED_OK) {
+            status = workers[t].status;
+        }
+    }
+
+    free(workers);
+
+    return status;
+}
+
+// simulate a worker's share of replicas
+void* replicaLoop(void* arg) {
+
+    ReplicaWorker* worker = (ReplicaWorker*) arg;
+    Replicas* replicas = worker->replicas;
+    int num_processes = worker->num_processes;
+
+    // per-thread workspace
+    Process* storage = (Process*) malloc(num_processes * sizeof(Process));
+    Process** processes = (Process**) malloc(num_processes * sizeof(Process*));
+    RL rl;
+    initRL(&rl);
+    Gantt gantt;
+    if (storage == NULL || processes == NULL || !initGantt(&gantt, num_processes * 2)) {
+        free(storage);
+        free(processes);
+        worker->status = SCHED_ERR_MEMORY;
+        return NULL;
+    }
+
+    for (int r = worker->first; r < replicas->count && worker->status == SCHED_OK; r += worker->stride) {
+
+        // seed from replica index (splitmix64 step so nearby seeds diverge)
+        uint64_t rng = (replicas->seed + (uint64_t) r + 1) * 0x9E3779B97F4A7C15ULL;
+        rng = (rng ^ (rng >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        rng = (rng ^ (rng >> 27)) * 0x94D049BB133111EBULL;
+        rng ^= rng >> 31;
+        if (rng == 0) {
+            rng = 1;
+        }
+
+        // perturb workload
+        for (int i = 0; i < num_processes; i++) {
+            Process* p = &storage[i];
+            *p = *worker->source[i];
+
+            // jitter arrival (never moving a non-negative arrival below 0)
+            if (replicas->jitter > 0) {
+                p->arrival += randomRange(&rng, -replicas->jitter, replicas->jitter);
+                if (p->arrival < 0 && worker->source[i]->arrival >= 0) {
+                    p->arrival = 0;
+                }
+            }
+
+            // bootstrap burst
+            p->burst = worker->source[nextRandom(&rng) % (uint64_t) num_processes]->burst;
+            p->remaining = p->burst;
+
+            processes[i] = p;
+        }
+        if (!sortProcesses(processes, num_processes)) {
+            worker->status = SCHED_ERR_MEMORY;
+            break;
+        }
+
+        // run selected policies
+        for (int k = 0; k < NUM_POLICIES; k++) {
+
+            if (!(replicas->policies & (1U << k))) {
+                continue;
+            }
+
+            Policy policy = POLICIES[k];
+            if (strcmp(policy.name, "RR") == 0) {
+                policy.quantum = replicas->quantum;
+            }
+
+            resetGantt(&gantt);
+            int64_t time;
+            SchedStatus status = simulate(&policy, &rl, processes, num_processes, &gantt, &time);
+            if (status != SCHED_OK) {
+                worker->status = status;
+                break;
+            }
+
+            // record replica metrics
+            double total_waiting = 0.0;
+            double total_turnaround = 0.0;
+            for (int i = 0; i < num_processes; i++) {
+                total_waiting += processes[i]->waiting;
+                total_turnaround += processes[i]->turnaround;
+            }
+            double* sample = replicaSample(replicas, r, k);
+            sample[REPLICA_WAITING] = total_waiting / num_processes;
+            sample[REPLICA_TURNAROUND] = total_turnaround / num_processes;
+            sample[REPLICA_THROUGHPUT] = (double) num_processes / time;
+        }
+    }
+
+    freeRL(&rl);
+    freeGantt(&gantt);
+    free(storage);
+    free(processes);
+
+    return NULL;
+}
+
+// metrics of replica r under policy k
+double* replicaSample(Replicas* replicas, int r, int k) {
+    return &replicas->samples[((size_t) r * NUM_POLICIES + k) * NUM_REPLICA_METRICS];
+}
+
+// mean and 95% confidence interval half-width of a metric over all replicas
+void replicaInterval(Replicas* replicas, int k, int metric, double* mean, double* half_width) {
+
+    // mean
+    double sum = 0.0;
+    for (int r = 0; r < replicas->count; r++) {
+        sum += replicaSample(replicas, r, k)[metric];
+    }
+    *mean = sum / replicas->count;
+
+    // sample standard deviation (no interval from a single replica)
+    *half_width = 0.0;
+    if (replicas->count < 2) {
+        return;
+    }
+    double squares = 0.0;
+    for (int r = 0; r < replicas->count; r++) {
+        double diff = replicaSample(replicas, r, k)[metric] - *mean;
+        squares += diff * diff;
+    }
+    double std_dev = sqrt(squares / (replicas->count - 1));
+
+    // student's t for small samples, normal beyond the table
+    int df = replicas->count - 1;
+    int table_size = sizeof(T_95) / sizeof(double);
+    double t = (df <= table_size) ? T_95[df - 1] : 1.96;
+
+    *half_width = t * std_dev / sqrt(replicas->count);
+}
+
+// print mean +/- 95% confidence interval of each metric per policy
+void printReplicas(FILE* out, Replicas* replicas) {
+
+    fprintf(out, "\n---------------------------- REPLICAS ----------------------------\n");
+    fprintf(out, "Replicas: %d (seed %" PRIu64 ", arrival jitter +/-%" PRId64 ", resampled bursts, %d threads)\n", \
+        replicas->count, replicas->seed, replicas->jitter, replicas->num_threads);
+    fprintf(out, "Mean +/- 95%% confidence interval\n\n");
+    fprintf(out, "\tPolicy\t|\tAvg. Waiting\t\t|\tAvg. Turnaround\t\t|\tThroughput\n");
+
+    for (int k = 0; k < NUM_POLICIES; k++) {
+
+        if (!(replicas->policies & (1U << k))) {
+            continue;
+        }
+
+        fprintf(out, "\t%s", POLICIES[k].name);
+        for (int metric = 0; metric < NUM_REPLICA_METRICS; metric++) {
+            double mean, half_width;
+            replicaInterval(replicas, k, metric, &mean, &half_width);
+            fprintf(out, "\t|\t%f +/- %f", mean, half_width);
+        }
+        fprintf(out, "\n");
+    }
+    fprintf(out, "\n");
+}
+
+// free replica samples
+void freeReplicas(Replicas* replicas) {
+    free(replicas->samples);
+    replicas->samples = NULL;
+}
@@ -1,728 +1,580 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdbool.h>
+#include "schedule.h"
 
 // GLOBAL VARIABLES
-const int ARG_SIZE = 5;
-
-// PROCESS STRUCTURE
-typedef struct Process {
-
-    // default fields
-    int pid;
-    int arrival;
-    int burst;
-    int priority;
-    int quantum;
-
-    // engineered fields
-    int remaining;
-    int waiting;
-    int turnaround;
-    int start;
-    int complete;   // completion time
-    bool finished;  // has been fully processed (preemption)
-    bool visited;
-} Process;
-
-// for ready list
-typedef struct Node {
-    Process* process; // a pointer to a process
-    struct Node* next;
-} Node;
-
-// ready list (linked list)
-typedef struct RL {
-    Node* head;
-} RL;
-
-// FUNCTION PROTOTYPES
-void fcfs(Process** processes, int num_processes);
-void sjf(RL* rl, Process** processes, int num_processes);
-void ps(RL* rl, Process** processes, int num_processes);
-void rr(RL* rl, Process** processes, int num_processes, int quantum);
-
-int processDiff(const void *p1, const void *p2);
-void printProcesses(Process** processes, int num_processes);
-Process* findProcess(Process** processes, int num_processes, int pid);
-
-void initRL(RL* rl);
-void addNode(RL* rl, Process* p);
-void addNodeRR(RL* rl, Process* p);
-void addAllNodesRR(RL* rl, Process** processes, int num_processes, int time);
-Process* removeNode(RL* rl);
-int isEmpty(RL* rl);
-void printList(RL* rl);
-void wipeProcessTimes(Process** processes, int num_processes);
+Telemetry* telemetry = NULL;    // time series recorder for each run (NULL = off)
+ArrivalSource* arrival_source = NULL;   // parser feeding the next run (NULL = already parsed)
+Trace* trace = NULL;            // trace events of each run's gantt slices (NULL = off)
+bool trace_only = false;        // gantt slices only go to trace (chart isn't kept)
+Machine* machine = NULL;        // multi-cpu model for each run (NULL = one cpu, no penalties)
+Checkpointing checkpointing = { NULL, 60.0, NULL };     // snapshot file, min seconds between snapshots, resume state
 
-// SCHEDULE FUNCTION DEFINITIONS
-void fcfs(Process** processes, int num_processes) {
-
-    // sort processes by arrival times (asc)
-    // uses processDiff as comparison function
-    qsort(processes, num_processes, sizeof(Process*), processDiff);
-
-    // array to handle gantt timeline (finite)
-    int gantt_size = num_processes * 2;
-    int gantt_pid[gantt_size];  // track pids in timeline
-    int gantt_start[gantt_size];    // track pid local start
-    int gantt_end[gantt_size];  // track pid local end
-    int gantt_i = 0;
-
-    // variable to represent schedule's current time
-    int time = 0;
-
-    // loop thru all processes
-    for (int i = 0; i < num_processes; i++) {
-        
-        // handle idle time
-        if (processes[i]->arrival > time) {
-
-            // add idle time to gantt
-            gantt_pid[gantt_i] = -1;    // idle pid = -1
-            gantt_start[gantt_i] = time;
-
-            // move time to nearest arrival
-            time = processes[i]->arrival;
+// MAIN CALL
+int main(int argc, char* argv[]) {
 
-            // update gantt end time
-            gantt_end[gantt_i++] = time;
+    // input file and server settings
+    const char* input_path = NULL;
+    const char* serve_path = NULL;
+    int num_workers = 0;
+    bool print_stats = false;
+
+    // quantum tuning settings
+    bool tune = false;
+    Tuning tuning = { SCHED_OBJECTIVE_AVG_WAITING, 1.0, 0, 0.0, 0, 0 };
+
+    // monte carlo replica settings (jitter -1 = mean gap between arrivals)
+    Replicas replicas = { 0, 1, -1, 0, 0, (1U << NUM_POLICIES) - 1, NULL };
+
+    // telemetry settings (ring -1 = 64 samples printed per run, or none when streaming)
+    int64_t telemetry_interval = 0;
+    const char* telemetry_path = NULL;
+    int telemetry_ring = -1;
+
+    // trace export settings
+    const char* trace_path = NULL;
+
+    // multi-cpu settings (one cpu without penalties = single cpu engine)
+    Machine cpus = { 1, 0, 0, true, 0, 0, 0 };
+
+    // read input file and options
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            serve_path = argv[++i];
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            num_workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpointing.path = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-interval") == 0 && i + 1 < argc) {
+            checkpointing.interval = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+            SchedStatus status = loadCheckpoint(argv[++i], &checkpointing.resume);
+            if (status != SCHED_OK) {
+                printf("ERROR %s\n", schedStatusMessage(status));
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--tune-quantum") == 0 && i + 1 < argc) {
+            tune = true;
+            i++;
+            if (strcmp(argv[i], "avg") == 0) {
+                tuning.objective = SCHED_OBJECTIVE_AVG_WAITING;
+            } else if (strcmp(argv[i], "p99") == 0) {
+                tuning.objective = SCHED_OBJECTIVE_P99_WAITING;
+            } else {
+                printf("INVALID CALL -- Unknown tuning objective: %s\n", argv[i]);
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--switch-cost") == 0 && i + 1 < argc) {
+            tuning.switch_weight = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--replicas") == 0 && i + 1 < argc) {
+            replicas.count = atoi(argv[++i]);
+            if (replicas.count <= 0) {
+                printf("INVALID CALL -- Replicas must be positive\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            replicas.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--jitter") == 0 && i + 1 < argc) {
+            replicas.jitter = strtoll(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            replicas.num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--policies") == 0 && i + 1 < argc) {
+            replicas.policies = parsePolicies(argv[++i]);
+        } else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetry_interval = strtoll(argv[++i], NULL, 10);
+            if (telemetry_interval <= 0) {
+                printf("INVALID CALL -- Telemetry interval must be positive\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--telemetry-out") == 0 && i + 1 < argc) {
+            telemetry_path = argv[++i];
+        } else if (strcmp(argv[i], "--telemetry-ring") == 0 && i + 1 < argc) {
+            telemetry_ring = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--trace-only") == 0) {
+            trace_only = true;
+        } else if (strcmp(argv[i], "--cpus") == 0 && i + 1 < argc) {
+            cpus.num_cpus = atoi(argv[++i]);
+            if (cpus.num_cpus <= 0) {
+                printf("INVALID CALL -- CPUs must be positive\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "--migration-cost") == 0 && i + 1 < argc) {
+            cpus.migration_cost = strtoll(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--cold-cost") == 0 && i + 1 < argc) {
+            cpus.cold_cost = strtoll(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--no-affinity") == 0) {
+            cpus.affinity = false;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            print_stats = true;
+        } else if (argv[i][0] != '-' && input_path == NULL) {
+            input_path = argv[i];
+        } else {
+            printf("INVALID CALL -- Unknown option: %s\n", argv[i]);
+            exit(1);
         }
+    }
 
-        // add process to gantt order
-        gantt_pid[gantt_i] = processes[i]->pid;
-        gantt_start[gantt_i] = time;
-
-        // update process's start time
-        processes[i]->start = time;
-
-        // move current time to termination of current process
-        time += processes[i]->burst;
-
-        // update gantt end time
-        gantt_end[gantt_i++] = time;
-
-        // compute turnaround time (completion - arrival)
-        processes[i]->turnaround = time - processes[i]->arrival;
-
-        // compute waiting time (turnaround - burst)
-        processes[i]->waiting = processes[i]->turnaround - processes[i]->burst;
-
-        // update process's completion time
-        processes[i]->complete = time;
+    // stats counters and phase timers are shared by every thread, so only
+    // single-threaded runs are profiled
+    if (print_stats && (serve_path != NULL || replicas.count > 0)) {
+        printf("INVALID CALL -- --stats can't be combined with --serve or --replicas\n");
+        exit(1);
+    }
 
+    // print summary on any exit (including errors)
+    if (print_stats) {
+#if STATS_ENABLED
+        atexit(printStats);
+#else
+        fprintf(stderr, "--stats ignored: build with 'make stats' to include instrumentation\n");
+#endif
     }
 
-    // print FCFS stats
-    printf("\n---------------------------- FCFS ----------------------------\n");
-    printf("\tPID\t|\tWaiting \t|\tTurnaround\n");
-    for (int i = 0; i < num_processes; i++) {
+    // daemon workers run requests concurrently and only print reports, so no
+    // run options (checkpoints and resume state are shared by every run)
+    if (serve_path != NULL && (input_path != NULL || checkpointing.path != NULL || checkpointing.resume != NULL || tune || \
+    replicas.count > 0 || telemetry_interval > 0 || telemetry_path != NULL || trace_path != NULL || trace_only || \
+    cpus.num_cpus > 1 || cpus.migration_cost != 0 || cpus.cold_cost != 0 || !cpus.affinity)) {
+        printf("INVALID CALL -- --serve takes no input file or run options besides --workers\n");
+        exit(1);
+    }
 
-        // print waiting/turnaround times
-        printf("\t %d\t|\t   %d\t\t|\t   %d\n", processes[i]->pid, processes[i]->waiting, processes[i]->turnaround);
+    // replicas run in parallel, so they don't checkpoint
+    if (replicas.count > 0 && (checkpointing.path != NULL || checkpointing.resume != NULL)) {
+        printf("INVALID CALL -- --replicas can't be combined with --checkpoint or --resume\n");
+        exit(1);
     }
-    printf("\n");
 
-    // print gantt chart
-    printf("Gantt Chart:\n");
-    for (int i = 0; i < gantt_i; i++) {
+    // replicas have no single timeline to trace, and a checkpoint needs the whole chart
+    if (trace_path != NULL && replicas.count > 0) {
+        printf("INVALID CALL -- --trace can't be combined with --replicas\n");
+        exit(1);
+    }
+    if (trace_only && (trace_path == NULL || checkpointing.path != NULL || checkpointing.resume != NULL)) {
+        printf("INVALID CALL -- --trace-only needs --trace and can't be combined with --checkpoint or --resume\n");
+        exit(1);
+    }
 
-        // print idle time or process lifecycle
-        if (gantt_pid[i] == -1) {
-            printf("[  %d  ]-----\tIDLE\t-----[  %d  ]\n", gantt_start[i], gantt_end[i]);    
-        } else {
-            printf("[  %d  ]-----\t%d\t-----[  %d  ]\n", gantt_start[i], gantt_pid[i], gantt_end[i]);
+    // model several cpus and/or migration penalties
+    if (cpus.migration_cost < 0 || cpus.cold_cost < 0) {
+        printf("INVALID CALL -- Penalties can't be negative\n");
+        exit(1);
+    }
+    if (cpus.num_cpus > 1 || cpus.migration_cost > 0 || cpus.cold_cost > 0) {
+        if (checkpointing.path != NULL || checkpointing.resume != NULL || replicas.count > 0 || telemetry_interval > 0) {
+            printf("INVALID CALL -- --cpus and penalties can't be combined with --checkpoint, --resume, --replicas or --telemetry\n");
+            exit(1);
         }
+        machine = &cpus;
     }
-    printf("\n");
-
-    // vars for time stats
-    double avg_turnaround = 0.0;
-    double avg_waiting = 0.0;
-    double throughput = (double) num_processes / time;
 
-    // calculate average turnaround & waiting times
-    for (int i = 0; i < num_processes; i++) {
-        avg_turnaround += processes[i]->turnaround;
-        avg_waiting += processes[i]->waiting;
+    // run as a daemon answering workloads over a unix socket
+    if (serve_path != NULL) {
+        return serve(serve_path, num_workers);
     }
 
-    avg_turnaround /= num_processes;
-    avg_waiting /= num_processes;
-
-    // display overall schedule stats
-    printf("Avg. Waiting Time: %f\n", avg_waiting);
-    printf("Avg. Turnaround: %f\n", avg_turnaround);
-    printf("Throughput: %f\n\n", throughput);
+    // check if num args is valid
+    if (input_path == NULL) {
+        printf("INVALID CALL -- Usage ... ./schedule test1.txt [--checkpoint file] [--checkpoint-interval secs] [--resume file] [--stats]\n");
+        printf("                       ./schedule test1.txt --telemetry interval [--telemetry-out file.csv] [--telemetry-ring n]\n");
+        printf("                       ./schedule test1.txt --trace file.json [--trace-only]\n");
+        printf("                       ./schedule test1.txt --cpus n [--migration-cost c] [--cold-cost c] [--no-affinity]\n");
+        printf("                       ./schedule test1.txt --tune-quantum avg|p99 [--switch-cost c]\n");
+        printf("                       ./schedule test1.txt --replicas k [--seed s] [--jitter j] [--threads n] [--policies fcfs,sjf,ps,rr]\n");
+        printf("                       ./schedule --serve socket [--workers n]\n");
+        exit(1);
+    }
 
-    time = 0;
+    // declare file i/o vars
+    FILE* file_ptr;
+    char ln[128];   // fits five 64-bit fields
 
-}
+    // declare process vars
+    Process** processes;
+    int num_processes = 0;
+    ArrivalSource source;
 
-// Shortest-Remaining-Time
-void sjf(RL* rl, Process** processes, int num_processes) {
+    // open file for reading
+    PHASE_BEGIN(PHASE_PARSE);
+    file_ptr = fopen(input_path, "r");
 
-    // reset all process fields to default
-    wipeProcessTimes(processes, num_processes);
+    // check if error occurred when opening the file
+    if (file_ptr == NULL) {
+        printf("ERROR reading file\n");
+        exit(1);
+    }
 
-    // sort processes by arrival times (asc)
-    // uses processDiff as comparison function
-    qsort(processes, num_processes, sizeof(Process*), processDiff);
+    // count the number of processes in file
+    while (fgets(ln, sizeof(ln), file_ptr)) {
+        num_processes++;
+    }
 
-    // array to handle gantt timeline (finite)
-    int gantt_size = num_processes * 5;
-    int gantt_pid[gantt_size];  // track pids in timeline
-    int gantt_start[gantt_size];    // track pid local start
-    int gantt_end[gantt_size];  // track pid local end
-    int gantt_i = 0;
-    bool gantt_idle = false;    // flag to detect if idle occurs
+    // reset file ptr to beginning of file
+    fseek(file_ptr, 0, SEEK_SET);
 
-    // variables to manage processes and time
-    int time = 0;
-    int completed = 0;
-    int curr_pid = -1;
-    Process* p = NULL;
+    // dynamically allocate memory for list of processes (one block of records)
+    processes = (Process**) malloc(num_processes * sizeof(Process*));
+    Process* storage = (Process*) malloc(num_processes * sizeof(Process));
+    STAT_ADD(allocations, 2);
 
-    // loop while RL isn't empty
-    while (completed < num_processes) {
+    // check if error occurred while allocating mem
+    if ((processes == NULL || storage == NULL) && num_processes > 0) {
+        printf("ERROR allocating memory for processes\n");
+        exit(1);
+    }
+    for (int j = 0; j < num_processes; j++) {
+        processes[j] = &storage[j];
+    }
 
-        // add processes to RL
-        for (int i = 0; i < num_processes; i++) {
+    // parse on a separate thread while the first schedule runs, unless a
+    // mode needs every process up front or writes the first run as it goes
+    // (the first run checks arrival order and is rerun if it isn't sorted)
+    bool pipelined = num_processes > 0 && checkpointing.path == NULL && checkpointing.resume == NULL && \
+        replicas.count == 0 && telemetry_path == NULL && trace_path == NULL && machine == NULL;
+    if (pipelined) {
+        if (!startSource(&source, file_ptr, processes, num_processes)) {
+            printf("ERROR starting parser thread\n");
+            exit(1);
+        }
+        arrival_source = &source;
+        PHASE_END(PHASE_PARSE);
+    } else {
 
-            // check if process not finished and arrival reached 
-            if (processes[i]->arrival <= time && !processes[i]->finished && !processes[i]->visited) {
+        // read file line-by-line
+        int j = 0;
+        while (fgets(ln, sizeof(ln), file_ptr) && j < num_processes) {
 
-                // add process to ready list
-                addNode(rl, processes[i]);
+            // create process object with line info
+            parseProcess(ln, processes[j]);
 
-                // mark process as visited (for gantt)
-                processes[i]->visited = true;
-            }
+            // increment to next process slot in process list
+            j++;
         }
+        PHASE_END(PHASE_PARSE);
 
-        // handle process if RL not empty
-        if (curr_pid == -1 && !isEmpty(rl)) {
-
-            // wrap up gantt idle time if previously idle
-            if (gantt_idle) {
-                gantt_idle = false;
-                gantt_end[gantt_i++] = time;
-            }
-
-            // remove next node from ready list
-            p = removeNode(rl);
+        // sort processes by arrival times once for all schedules
+        PHASE_BEGIN(PHASE_SORT);
+        if (!sortProcesses(processes, num_processes)) {
+            printf("ERROR allocating memory for sort\n");
+            exit(1);
+        }
+        PHASE_END(PHASE_SORT);
+    }
 
-            // toggle current pid
-            curr_pid = p->pid;
-            // printf("Process %d started at time %d\n", p->pid, time);
+    // initialize ready list
+    RL* rl = (RL*) malloc (sizeof(RL));
+    if (rl == NULL) {
+        printf("Error allocating mem for ready list\n");
+        exit(1);
+    }
+    initRL(rl);    
 
-            // update process start time
-            if (!p->visited) {
-                p->start = time;
+    // report variance over perturbed replicas instead of single schedules
+    if (replicas.count > 0) {
+        runReplicaMode(processes, num_processes, &replicas);
+        fclose(file_ptr);
+        free(storage);
+        free(processes);
+        freeRL(rl);
+        free(rl);
+        return 0;
+    }
+
+    // sample each run's ready list depth and cpu use
+    Telemetry recorder;
+    FILE* telemetry_file = NULL;
+    if (telemetry_interval > 0) {
+
+        // stream every sample to a csv file
+        if (telemetry_path != NULL) {
+            telemetry_file = fopen(telemetry_path, "w");
+            if (telemetry_file == NULL) {
+                printf("ERROR opening telemetry file\n");
+                exit(1);
             }
-
-            // add process pid/start to gantt chart (only inc. when preempted/finished)
-            gantt_pid[gantt_i] = p->pid;
-            gantt_start[gantt_i] = time;
-
         }
 
-        // run current pid for 1 time unit
-        if (curr_pid != -1) {
-
-            // increment time by 1
-            time++;
-
-            // update remaining time of current process
-            p->remaining -= 1;
-
-            // check if process is done
-            if (p->remaining == 0) {
-
-                // mark process as finished
-                p->finished = true;
-
-                // remove current process (new process from RL next iter.)
-                curr_pid = -1;
-                // printf("Process %d finished at time %d\n", p->pid, time);
-
-                // update process completion time
-                p->complete = time;
-
-                // compute process turnaround time (completion - arrival)
-                p->turnaround = time - p->arrival;
-
-                // compute process waiting time (turnaround - burst)
-                p->waiting = p->turnaround - p->burst;
-
-                // add end time to gantt and increment to next gantt event
-                gantt_end[gantt_i++] = time;
-
-                // update completed processes count
-                completed++;
-
-            // process not done, check preemption
-            } else {
-
-                // check if preemption available
-                for (int i = 0; i < num_processes; i++) {
+        // keep the latest samples to print with each schedule
+        if (telemetry_ring < 0) {
+            telemetry_ring = (telemetry_file == NULL) ? 64 : 0;
+        }
+        if (!initTelemetry(&recorder, telemetry_interval, telemetry_ring, telemetry_file)) {
+            printf("ERROR allocating memory for telemetry\n");
+            exit(1);
+        }
+        telemetry = &recorder;
+    }
 
-                    // see if any other processes can trigger preemption
-                    if (processes[i]->arrival <= time && !processes[i]->finished && !processes[i]->visited && \
-                    processes[i]->remaining < p->remaining)
-                    {
-                        // preempt current process ----
+    // stream each run's gantt slices as trace events
+    Trace exporter;
+    FILE* trace_file = NULL;
+    if (trace_path != NULL) {
+        trace_file = fopen(trace_path, "w");
+        if (trace_file == NULL) {
+            printf("ERROR opening trace file\n");
+            exit(1);
+        }
+        setvbuf(trace_file, NULL, _IOFBF, 1 << 16);
+        openTrace(&exporter, trace_file);
+        trace = &exporter;
 
-                        // add current process back into ready list
-                        addNode(rl, p);
-                        // printf("Process %d preempted at time %d\n", p->pid, time);
+        // errors exit mid-run, the file still gets its footer
+        atexit(endTrace);
+    }
 
-                        // add local end time to gantt and increment to next gantt event
-                        gantt_end[gantt_i++] = time;
+    // CALL SCHEDULE FUNCTIONS
 
-                        // empty current process for rescheduling (next increment)
-                        curr_pid = -1;
+    // run First-Come-First-Serve on file info
+    fcfs(rl, processes, num_processes);
 
-                        break;
-                    }
-                }
-            }
+    // run Shortest-Remaining-Time on file info
+    sjf(rl, processes, num_processes);
 
-        // idle
-        } else {
+    // run Priority Scheduling
+    ps(rl, processes, num_processes);
 
-            // update gantt start/pid (idle = -1)
-            if (!gantt_idle) {
-                gantt_start[gantt_i] = time;
-                gantt_pid[gantt_i] = -1;
-            }
+    // run Round-Robin on file info (processes without their own quantum use the first arrival's)
+    int64_t quantum = processes[0]->quantum;
+    rr(rl, processes, num_processes, quantum);
 
-            // toggle gantt idle flag
-            gantt_idle = true;
+    // search for the best single quantum and run Round-Robin with it
+    if (tune) {
+        tuneRr(rl, processes, num_processes, &tuning);
+    }
 
-            time++;
+    // all schedules finished, snapshot no longer needed
+    if (checkpointing.path != NULL) {
+        remove(checkpointing.path);
+    }
 
-        }
+    // CLEAN MEMORY AND FILE I/O
 
+    // close telemetry
+    if (telemetry != NULL) {
+        freeTelemetry(telemetry);
+        telemetry = NULL;
+    }
+    if (telemetry_file != NULL) {
+        fclose(telemetry_file);
     }
 
-    // print SJF stats
-    printf("\n---------------------------- SJF ----------------------------\n");
-    printf("\tPID\t|\tWaiting \t|\tTurnaround\n");
-    for (int i = 0; i < num_processes; i++) {
-
-        // print waiting/turnaround times
-        printf("\t %d\t|\t   %d\t\t|\t   %d\n", processes[i]->pid, processes[i]->waiting, processes[i]->turnaround);
+    // close trace
+    if (trace != NULL) {
+        closeTrace(trace);
+        trace = NULL;
+        fclose(trace_file);
     }
-    printf("\n");
 
-    // print gantt chart
-    printf("Gantt Chart:\n");
-    for (int i = 0; i < gantt_i; i++) {
+    // close the file
+    fclose(file_ptr);
 
-        // print idle time or process lifecycle
-        if (gantt_pid[i] == -1) {
-            printf("[  %d  ]-----\tIDLE\t-----[  %d  ]\n", gantt_start[i], gantt_end[i]);    
-        } else {
-            printf("[  %d  ]-----\t%d\t-----[  %d  ]\n", gantt_start[i], gantt_pid[i], gantt_end[i]);
-        }
-    }
-    printf("\n");
+    // free process memory
+    free(storage);
+    free(processes);
 
+    // free ready list memory
+    freeRL(rl);
+    free(rl);
 
-    // vars for time stats
-    double avg_turnaround = 0.0;
-    double avg_waiting = 0.0;
-    double throughput = (double) num_processes / time;
+    return 0;
 
-    // calculate average turnaround & waiting times
-    for (int i = 0; i < num_processes; i++) {
-        avg_turnaround += processes[i]->turnaround;
-        avg_waiting += processes[i]->waiting;
-    }
+}
 
-    avg_turnaround /= num_processes;
-    avg_waiting /= num_processes;
+// SCHEDULE FUNCTION DEFINITIONS
 
-    // display overall schedule stats
-    printf("Avg. Waiting Time: %f\n", avg_waiting);
-    printf("Avg. Turnaround: %f\n", avg_turnaround);
-    printf("Throughput: %f\n\n", throughput);
+// First-Come-First-Serve
+void fcfs(RL* rl, Process** processes, int num_processes) {
+    runPolicy(findPolicy("FCFS"), rl, processes, num_processes);
+}
 
+// Shortest-Remaining-Time
+void sjf(RL* rl, Process** processes, int num_processes) {
+    runPolicy(findPolicy("SJF"), rl, processes, num_processes);
 }
 
 // Priority Scheduling (w/o preemption)
 void ps(RL* rl, Process** processes, int num_processes) {
+    runPolicy(findPolicy("PS"), rl, processes, num_processes);
+}
 
-    // reset all process fields to default
-    wipeProcessTimes(processes, num_processes);
-
-    // sort processes by arrival times (asc)
-    // uses processDiff as comparison function
-    qsort(processes, num_processes, sizeof(Process*), processDiff);
-
-    // array to handle gantt timeline (finite)
-    int gantt_size = num_processes * 2;
-    int gantt_pid[gantt_size];  // track pids in timeline
-    int gantt_start[gantt_size];    // track pid local start
-    int gantt_end[gantt_size];  // track pid local end
-    int gantt_i = 0;
-    bool gantt_idle = false;    // flag to detect if idle occurs
-
-    // var to track time
-    int time = 0;
+// Round Robin
+void rr(RL* rl, Process** processes, int num_processes, int64_t quantum) {
 
-    // var to track num finished processes
-    int completed = 0;
+    // exit if quantum is invalid
+    if (quantum <= 0) {
+        printf("Error invalid quantum: %" PRId64 "\n", quantum);
+        exit(1);
+    }
 
-    // var to hold running process
-    Process* p = NULL;
+    // set quantum of round robin
+    Policy policy = *findPolicy("RR");
+    policy.quantum = quantum;
 
-    // loop until all processes are done
-    while (completed < num_processes) {
+    runPolicy(&policy, rl, processes, num_processes);
+}
 
-        // vars to track process with the highest priority
-        int top_priority = 100000;
-        int top_i = -1;
+// Round Robin with the quantum (same for every process) that minimizes tuning's objective
+void tuneRr(RL* rl, Process** processes, int num_processes, Tuning* tuning) {
 
-        // loop thru all processes
-        for (int i = 0; i < num_processes; i++) {
+    // search quanta
+    SchedStatus status = tuneQuantum(rl, processes, num_processes, tuning);
+    if (status != SCHED_OK) {
+        printf("ERROR %s\n", schedStatusMessage(status));
+        exit(1);
+    }
 
-            // check if process can be added to RL
-            if (processes[i]->arrival <= time && !processes[i]->finished) {
+    // print search results
+    printf("\n---------------------------- RR TUNING ----------------------------\n");
+    printf("Objective: %s waiting + %f per context switch per process\n", \
+        (tuning->objective == SCHED_OBJECTIVE_AVG_WAITING) ? "avg." : "p99", tuning->switch_weight);
+    printf("Best Quantum: %" PRId64 " (cost %f)\n", tuning->quantum, tuning->cost);
+    printf("Simulations: %d (%d stopped early)\n", tuning->runs, tuning->cut_short);
 
-                // compare priority
-                if (processes[i]->priority < top_priority) {
+    // run with the tuned quantum
+    Policy policy = *findPolicy("RR");
+    policy.name = "RR TUNED";
+    policy.quantum = tuning->quantum;
+    policy.job_quanta = false;
 
-                    // set new top priority
-                    top_priority = processes[i]->priority;
-                    top_i = i;
+    runPolicy(&policy, rl, processes, num_processes);
+}
 
-                }
+// run and print monte carlo replicas of processes (exits on engine errors)
+void runReplicaMode(Process** processes, int num_processes, Replicas* replicas) {
 
+    // default jitter: mean gap between arrivals (at least 1)
+    if (replicas->jitter < 0) {
+        replicas->jitter = 1;
+        if (num_processes > 1) {
+            int64_t gap = (processes[num_processes - 1]->arrival - processes[0]->arrival) / (num_processes - 1);
+            if (gap > 1) {
+                replicas->jitter = gap;
             }
-
         }
+    }
 
-        // if top priority process exists, handle it
-        if (top_i != -1) {
-
-            // wrap up idle
-            if (gantt_idle) {
-
-                gantt_end[gantt_i++] = time;
-                gantt_idle = false;
-
-            }
-
-            // get top priority process
-            Process* p = processes[top_i];
-
-            // check if memory allocated properly
-            if (p == NULL) {
-                printf("ERROR allocating memory for process in PS\n");
-                exit(1);
-            }
-
-            // update gantt
-            gantt_pid[gantt_i] = p->pid;
-            gantt_start[gantt_i] = time;
-
-            // update number of completed processes
-            completed++;
-
-            // update process start time
-            p->start = time;
-
-            // update time by process burst
-            time += p->burst;
-
-            // update process completion time
-            p->complete = time;
-
-            // calculate process turnaround and waiting times
-            p->turnaround = time - p->arrival;
-            p->waiting = p->turnaround - p->burst;
-
-            // update process finished flag
-            p->finished = true;
+    // same round robin quantum as a single run
+    replicas->quantum = processes[0]->quantum;
 
-            // update gantt chart
-            gantt_end[gantt_i++] = time;
+    SchedStatus status = runReplicas(processes, num_processes, replicas);
+    if (status == SCHED_ERR_QUANTUM) {
+        printf("Error invalid quantum: %" PRId64 "\n", replicas->quantum);
+        exit(1);
+    } else if (status != SCHED_OK) {
+        printf("ERROR %s\n", schedStatusMessage(status));
+        exit(1);
+    }
 
-        // if no process, idle
-        } else {
+    printReplicas(stdout, replicas);
+    freeReplicas(replicas);
+}
 
-            // update gantt chart (idle pid = -1)
-            if(!gantt_idle) {
-                gantt_start[gantt_i] = time;
-            }
-            gantt_pid[gantt_i] = -1;
-            gantt_idle = true;
+// parse a comma separated list of policy names into a POLICIES bitmask
+unsigned parsePolicies(const char* list) {
 
-            // update time
-            time++;
+    unsigned policies = 0;
+    char names[64];
+    snprintf(names, sizeof(names), "%s", list);
 
+    char* save = NULL;
+    for (char* name = strtok_r(names, ",", &save); name != NULL; name = strtok_r(NULL, ",", &save)) {
+        const Policy* policy = findPolicy(name);
+        if (policy == NULL) {
+            printf("INVALID CALL -- Unknown policy: %s\n", name);
+            exit(1);
         }
-
+        policies |= 1U << (policy - POLICIES);
     }
 
-    // print PS stats
-    printf("\n---------------------------- PS ----------------------------\n");
-    printf("\tPID\t|\tWaiting \t|\tTurnaround\n");
-    for (int i = 0; i < num_processes; i++) {
-
-        // print waiting/turnaround times
-        printf("\t %d\t|\t   %d\t\t|\t   %d\n", processes[i]->pid, processes[i]->waiting, processes[i]->turnaround);
-    }
-    printf("\n");
+    return policies;
+}
 
-    // print gantt chart
-    printf("Gantt Chart:\n");
-    for (int i = 0; i < gantt_i; i++) {
+// simulate a policy and print its stats (exits on engine errors)
+void runPolicy(const Policy* policy, RL* rl, Process** processes, int num_processes) {
 
-        // print idle time or process lifecycle
-        if (gantt_pid[i] == -1) {
-            printf("[  %d  ]-----\tIDLE\t-----[  %d  ]\n", gantt_start[i], gantt_end[i]);    
-        } else {
-            printf("[  %d  ]-----\t%d\t-----[  %d  ]\n", gantt_start[i], gantt_pid[i], gantt_end[i]);
+    // when resuming, skip policies that finished before the checkpoint
+    if (checkpointing.resume != NULL) {
+        if (strcmp(checkpointing.resume->policy, policy->name) != 0) {
+            return;
         }
+        fprintf(stderr, "Resumed %s at time %" PRId64 "\n", checkpointing.resume->policy, checkpointing.resume->time);
     }
-    printf("\n");
-
-    // vars for time stats
-    double avg_turnaround = 0.0;
-    double avg_waiting = 0.0;
-    double throughput = (double) num_processes / time;
 
-    // calculate average turnaround & waiting times
-    for (int i = 0; i < num_processes; i++) {
-        avg_turnaround += processes[i]->turnaround;
-        avg_waiting += processes[i]->waiting;
-    }
-
-    avg_turnaround /= num_processes;
-    avg_waiting /= num_processes;
-
-    // display overall schedule stats
-    printf("Avg. Waiting Time: %f\n", avg_waiting);
-    printf("Avg. Turnaround: %f\n", avg_turnaround);
-    printf("Throughput: %f\n\n", throughput);
-
-
-}
-
-// Round Robin
-void rr(RL* rl, Process** processes, int num_processes, int quantum) {
-
-    // exit if quantum is invalid
-    if (quantum <= 0) {
-        printf("Error invalid quantum: %d\n", quantum);
+    // gantt timeline of each cpu for this run (nothing is kept when it's only traced)
+    int num_cpus = (machine != NULL) ? machine->num_cpus : 1;
+    Gantt* gantts = (Gantt*) malloc(num_cpus * sizeof(Gantt));
+    if (gantts == NULL) {
+        printf("ERROR allocating memory for gantt chart\n");
         exit(1);
     }
-
-    // reset all process info to default
-    wipeProcessTimes(processes, num_processes);
-
-    // sort processes by arrival times (asc)
-    // uses processDiff as comparison function
-    qsort(processes, num_processes, sizeof(Process*), processDiff);
-
-    // vars for scheduling
-    int time = 0;
-    int completed = 0;
-
-    // vars for gantt
-    int gantt_size = num_processes * 8;
-    int gantt_pid[gantt_size];  // track pids in timeline
-    int gantt_start[gantt_size];    // track pid local start
-    int gantt_end[gantt_size];  // track pid local end
-    int gantt_i = 0;
-    bool gantt_idle = false;    // flag to detect if idle occurs
-
-    // loop until all processes finished
-    while (completed < num_processes) {
-
-        for (int i = 0; i < num_processes; i++) {
-
-            // add new processes to ready list
-            if (processes[i]->arrival <= time && !processes[i]->finished && !processes[i]->visited) {
-                
-                // add process to ready list TODO: add nodes by arrival during quantum (before completion)
-                addNodeRR(rl, processes[i]);
-
-                // mark process as visited
-                processes[i]->visited = true;
-            }
+    if (trace != NULL) {
+        startTrace(trace, policy->name);
+    }
+    for (int c = 0; c < num_cpus; c++) {
+        if (!initGantt(&gantts[c], trace_only ? 1 : num_processes * 2 / num_cpus)) {
+            printf("ERROR allocating memory for gantt chart\n");
+            exit(1);
         }
+        gantts[c].trace = trace;
+        gantts[c].cpu = c;
+        gantts[c].discard = trace_only;
+    }
+    Gantt* gantt = &gantts[0];
+
+    // run the schedule (the first run takes processes as they're parsed)
+    int64_t time;
+    ArrivalSource* source = arrival_source;
+    arrival_source = NULL;
+    SchedStatus status;
+    if (machine != NULL) {
+        status = simulateCpus(policy, rl, processes, num_processes, gantts, &time, machine);
+    } else {
+        status = simulateWith(policy, rl, processes, num_processes, gantt, &time, NULL, telemetry, source, NULL, &checkpointing);
+    }
+    if (source != NULL) {
+        finishSource(source);
 
-        // handle process if RL not empty
-        if (!isEmpty(rl)) {
-
-            // wrap update gantt idle
-            if (gantt_idle) {
-                gantt_end[gantt_i++] = time;
-                gantt_idle = false;
-            }
-
-            // get next node from ready list
-            Process* p = removeNode(rl);
-
-            // check if process can run through quantum length
-            if (p->remaining > quantum) {
-
-                // printf("Process %d ran from %d to %d\n", p->pid, time, time + quantum);
-
-                // update gantt start/pid
-                gantt_start[gantt_i] = time;
-                gantt_pid[gantt_i] = p->pid;
-
-                // update time
-                time += quantum;
-
-                // update gantt end
-                gantt_end[gantt_i++] = time;
-
-                // // aggregate process time fragment (redacted)
-                // if (gantt_i != 0 && gantt_pid[gantt_i - 1] == p->pid) {
-
-                //     // update prev gantt entry's end time to now
-                //     gantt_end[gantt_i - 1] = time;
-
-                // } else {
-                //     gantt_end[gantt_i++] = time;   
-                // }
-
-                // update process's remaining time
-                p->remaining -= quantum;
-
-                // add all nodes that became available between quantum change
-                addAllNodesRR(rl, processes, num_processes, time);
-
-                // put process back into ready list
-                addNodeRR(rl, p);
-
-            // process has less remaining time than quantum
-            } else {
-
-                // update gantt start/pid
-                gantt_start[gantt_i] = time;
-                gantt_pid[gantt_i] = p->pid;
-
-                // update time by remaining time
-                time += p->remaining;
-
-                // update gantt end
-                gantt_end[gantt_i++] = time;
-
-                // // aggregate process time fragment (redacted)
-                // if (gantt_i != 0 && gantt_pid[gantt_i - 1] == p->pid) {
-
-                //     // update prev gantt entry's end time to now
-                //     gantt_end[gantt_i - 1] = time;
-                    
-                // } else {
-                //     gantt_end[gantt_i++] = time;   
-                // }
-
-                // update process's remaining time
-                p->remaining = 0;
-
-                completed++;
-
-                p->complete = time;
-
-                // compute turnaround and waiting times
-                p->turnaround = p->complete - p->arrival;
-                p->waiting = p->turnaround - p->burst;
-
-                // printf("Process %d completed at time %d\n", p->pid, time);
-
-            }
-
-        // run idle
-        } else {
-
-            // update gantt start/pid (idle = -1)
-            if (!gantt_idle) {
-                gantt_start[gantt_i] = time;
-                gantt_pid[gantt_i] = -1;
+        // input wasn't in arrival order: sort it once for all schedules and run again
+        if (status == SCHED_ERR_UNSORTED) {
+            PHASE_BEGIN(PHASE_SORT);
+            if (!sortProcesses(processes, num_processes)) {
+                printf("ERROR allocating memory for sort\n");
+                exit(1);
             }
-
-            // toggle gantt idle flag
-            gantt_idle = true;
-
-            time++;
-
-            // printf("Idle\n");
-
+            PHASE_END(PHASE_SORT);
+            resetGantt(gantt);
+            status = simulateWith(policy, rl, processes, num_processes, gantt, &time, NULL, telemetry, NULL, NULL, &checkpointing);
         }
     }
-
-    // print RR stats
-    printf("\n---------------------------- RR ----------------------------\n");
-    printf("\tPID\t|\tWaiting \t|\tTurnaround\n");
-    for (int i = 0; i < num_processes; i++) {
-
-        // print waiting/turnaround times
-        printf("\t %d\t|\t   %d\t\t|\t   %d\n", processes[i]->pid, processes[i]->waiting, processes[i]->turnaround);
+    if (status != SCHED_OK) {
+        printf("ERROR %s\n", schedStatusMessage(status));
+        exit(1);
     }
-    printf("\n");
 
-    // print gantt chart
-    printf("Gantt Chart:\n");
-    for (int i = 0; i < gantt_i; i++) {
-
-        // print idle time or process lifecycle
-        if (gantt_pid[i] == -1) {
-            printf("[  %d  ]-----\tIDLE\t-----[  %d  ]\n", gantt_start[i], gantt_end[i]);    
-        } else {
-            printf("[  %d  ]-----\t%d\t-----[  %d  ]\n", gantt_start[i], gantt_pid[i], gantt_end[i]);
-        }
+    // print stats for the schedule
+    PHASE_BEGIN(PHASE_REPORT);
+    printSchedule(stdout, policy->name, processes, num_processes, gantts, num_cpus, time, machine);
+    if (telemetry != NULL && telemetry->capacity > 0) {
+        printTelemetry(stdout, telemetry);
     }
-    printf("\n");
+    PHASE_END(PHASE_REPORT);
 
-    // vars for time stats
-    double avg_turnaround = 0.0;
-    double avg_waiting = 0.0;
-    double throughput = (double) num_processes / time;
-
-    // calculate average turnaround & waiting times
-    for (int i = 0; i < num_processes; i++) {
-        avg_turnaround += processes[i]->turnaround;
-        avg_waiting += processes[i]->waiting;
+    for (int c = 0; c < num_cpus; c++) {
+        freeGantt(&gantts[c]);
     }
-
-    avg_turnaround /= num_processes;
-    avg_waiting /= num_processes;
-
-    // display overall schedule stats
-    printf("Avg. Waiting Time: %f\n", avg_waiting);
-    printf("Avg. Turnaround: %f\n", avg_turnaround);
-    printf("Throughput: %f\n\n", throughput);
-
-
+    free(gantts);
 }
 
-// HELPER FUNCTION DEFINITIONS
-
-// helper to compare process arrival/pid for sorting
-int processDiff(const void *p1, const void *p2) {
-
-    // convert process ptrs to processes
-    Process* process1 = *(Process**)p1;
-    Process* process2 = *(Process**)p2;
-
-    // return pid difference if arrival times are the same
-    if (process1->arrival == process2->arrival) {
-        return process1->pid - process2->pid;
+// close the trace if a run exits before main does (exit flushes the file)
+void endTrace() {
+    if (trace != NULL) {
+        closeTrace(trace);
+        trace = NULL;
     }
-
-    // return the arrival time difference btw processes
-    return process1->arrival - process2->arrival;
 }
 
+// DEBUG FUNCTION DEFINITIONS
+
 // print general info about processes
 void printProcesses(Process** processes, int num_processes) {
 
@@ -730,7 +582,7 @@ void printProcesses(Process** processes, int num_processes) {
     printf("--------------------------------------------------------------------------------------------------------------------------------\n");
 
     for (int j = 0; j < num_processes; j++) {
-        printf("\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\n", \
+        printf("\t%d\t|\t%" PRId64 "\t|\t%" PRId64 "\t|\t%d\t|\t%" PRId64 "\t|\t%" PRId64 "\t|\t%" PRId64 "\t|\t%" PRId64 "\n", \
             processes[j]->pid,
             processes[j]->arrival,
             processes[j]->burst,
@@ -742,145 +594,6 @@ void printProcesses(Process** processes, int num_processes) {
         );
     }
     printf("\n");
-
-}
- 
-// find process object reference by pid
-Process* findProcess(Process** processes, int num_processes, int pid) {
-    for (int i = 0; i < num_processes; i++) {
-        if (processes[i]->pid == pid) {
-            return processes[i];
-        }
-    }
-    
-    // display error if process not found
-    printf("No process with PID: %d exists", pid);
-    exit(1);
-}
-
-// READY LIST FUNCTIONS
-
-// initialize head of a new ready list (linked list)
-void initRL(RL* rl) {
-    rl->head = NULL;
-}
-
-// add a node to the ready list (node->process)
-void addNode(RL* rl, Process* p) {
-
-    // alloc mem for new node
-    Node* node = (Node*) malloc (sizeof(Node));
-
-    // set new node's info
-    node->process = p; // node->process is a pointer to a process
-    node->next = NULL;
-
-    if (isEmpty(rl) || p->remaining < rl->head->process->remaining) {
-        node->next = rl->head;
-        rl->head = node;
-    } else {
-
-        Node* curr = rl->head;
-
-        // find end of list TODO: consider fixing this to be simpler
-        if (!p->visited) {
-            while (curr->next != NULL && curr->next->process->remaining < p->remaining) {
-                curr = curr->next;
-            }
-        } else {
-            while (curr->next != NULL) {
-                curr = curr->next;
-            }
-        }
-        // while (curr->next != NULL && curr->next->process->remaining < p->remaining) {
-        //     curr = curr->next;
-        // }
-
-        // add node to end of list
-        node->next = curr->next;
-        curr->next = node;
-    }
-}
-
-// add a node to the ready list (node->process)
-void addNodeRR(RL* rl, Process* p) {
-
-    // alloc mem for new node
-    Node* node = (Node*) malloc (sizeof(Node));
-
-    // set new node's info
-    node->process = p; // node->process is a pointer to a process
-    node->next = NULL;
-
-    // add to head of list of list is empty
-    if (isEmpty(rl)) {
-        node->next = rl->head;
-        rl->head = node;
-    } else {
-
-        // set tracker node
-        Node* curr = rl->head;
-
-        // find end of ready list
-        while (curr->next != NULL) {
-            curr = curr->next;
-        }        
-
-        // add node to end of list
-        node->next = curr->next;
-        curr->next = node;
-    }
-}
-
-// add all available nodes to ready list
-void addAllNodesRR(RL* rl, Process** processes, int num_processes, int time) {
-
-    for (int i = 0; i < num_processes; i++) {
-
-        // add new processes to ready list
-        if (processes[i]->arrival <= time && !processes[i]->finished && \
-        !processes[i]->visited) {
-            
-            // add process to ready list TODO: add nodes by arrival during quantum (before completion)
-            addNodeRR(rl, processes[i]);
-
-            // mark process as visited
-            processes[i]->visited = true;
-        }
-
-    }
-}
-
-// check if ready list is empty
-int isEmpty(RL* rl) {
-
-    // return if ready list's head points to nothing
-    return (rl->head == NULL);
-}
-
-// remove node from ready list (FIFO)
-Process* removeNode(RL* rl) {
-    
-    // check if RL has any processes
-    if (isEmpty(rl)) {
-        printf("RL is empty. Can't remove");
-        exit(1);
-    }
-
-    // get node to remove
-    Node* node = rl->head;
-
-    // set new head
-    rl->head = rl->head->next;
-
-    // save process associated with node
-    Process* p = node->process;
-
-    // deallocate node from mem
-    free(node);
-
-    // return process of deleted node
-    return p;
 }
 
 // print all nodes currently in ready list
@@ -902,132 +615,3 @@ void printList(RL* rl) {
     }
     printf("\n");
 }
-
-// wipe time info for all processes
-void wipeProcessTimes(Process** processes, int num_processes) {
-
-    // reset all but pid, arrival, burst, priority, and quantum 
-    for (int i = 0; i < num_processes; i++) {
-        processes[i]->remaining = processes[i]->burst;
-        processes[i]->start = 0;
-        processes[i]->complete = 0;
-        processes[i]->finished = false;
-        processes[i]->visited = false;
-    }
-}
-
-// MAIN CALL
-int main(int argc, char* argv[]) {
-
-    // check if num args is valid
-    if (argc != 2) {
-        printf("INVALID CALL -- Usage ... ./schedule test1.txt\n");
-        exit(1);
-    }
-
-    // declare file i/o vars
-    FILE* file_ptr;
-    char ln[16];
-    const char comma[] = ",";
-
-    // declare process vars
-    Process** processes;
-    int num_processes = 0;
-
-    // open file for reading
-    file_ptr = fopen(argv[1], "r");
-
-    // check if error occurred when opening the file
-    if (file_ptr == NULL) {
-        printf("ERROR reading file\n");
-        exit(1);
-    }
-
-    // count the number of processes in file
-    while (fgets(ln, sizeof(ln), file_ptr)) {
-        num_processes++;
-    }
-
-    // reset file ptr to beginning of file
-    fseek(file_ptr, 0, SEEK_SET);
-
-    // dynamically allocate memory for list of processes
-    processes = (Process**) malloc(num_processes * sizeof(Process*));
-
-    // check if error occurred while allocating mem
-    if (processes == NULL) {
-        printf("ERROR allocating memory for processes\n");
-        exit(1);
-    }
-
-    // read file line-by-line
-    int j = 0;
-    while (fgets(ln, sizeof(ln), file_ptr) && j < num_processes) {
-
-        // allocate memory for new process
-        processes[j] = (Process*) malloc (sizeof(Process));
-
-        // check if memory was allocated correctly
-        if (processes[j] == NULL) {
-            printf("Error allocating memory for new process");
-            exit(1);
-        }
-
-        // create process object with line info 
-        sscanf(ln, "%d,%d,%d,%d,%d",
-            &(processes[j]->pid),
-            &(processes[j]->arrival),
-            &(processes[j]->burst),
-            &(processes[j]->priority),
-            &(processes[j]->quantum)
-        );
-
-        // set engineered process info
-        processes[j]->remaining = processes[j]->burst;
-        processes[j]->waiting = 0;
-        processes[j]->turnaround = 0;
-        processes[j]->complete = 0;
-        processes[j]->finished = false;
-        processes[j]->visited = false;
-
-        // increment to next process slot in process list
-        j++;
-    }
-
-    // initialize ready list
-    RL* rl = (RL*) malloc (sizeof(RL));
-    if (rl == NULL) {
-        printf("Error allocating mem for ready list\n");
-        exit(1);
-    }
-    initRL(rl);    
-
-    // CALL SCHEDULE FUNCTIONS
-
-    // run First-Come-First-Serve on file info
-    fcfs(processes, num_processes);
-
-    // run Shortest-Remaining-Time on file info
-    sjf(rl, processes, num_processes);
-
-    // run Priority Scheduling
-    ps(rl, processes, num_processes);
-
-    // run Round-Robin on file info
-    int quantum = processes[0]->quantum;
-    rr(rl, processes, num_processes, quantum);
-
-    // CLEAN MEMORY AND FILE I/O
-
-    // close the file
-    fclose(file_ptr);
-
-    // free process memory
-    free(processes);
-
-    // free ready list memory
-    free(rl);
-
-    return 0;
-
-}
\ No newline at end of file
@@ -0,0 +1,381 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <time.h>
+#include <float.h>
+#include <pthread.h>
+#include "wheel.h"
+#include "stats.h"
+#include "libschedule.h"
+
+// GLOBAL VARIABLES
+#define SOURCE_RING_SIZE 64     // batches in flight between parser and simulator
+#define SOURCE_BATCH 4096       // processes per batch
+extern const int ARG_SIZE;
+extern const int CHECKPOINT_VERSION;
+extern const int CHECKPOINT_CHECK_EVENTS;
+extern const double CHECKPOINT_OVERHEAD;
+extern const int TUNING_GRID;
+
+// PROCESS STRUCTURE
+typedef struct Process {
+
+    // default fields
+    int pid;
+    int64_t arrival;
+    int64_t burst;
+    int priority;
+    int64_t quantum;
+
+    // engineered fields
+    int64_t remaining;
+    int64_t waiting;
+    int64_t turnaround;
+    int64_t start;
+    int64_t complete;   // completion time
+    bool finished;  // has been fully processed (preemption)
+    bool visited;
+    int index;      // position in arrival order
+    int cpu;        // cpu last run on (-1 = not run yet)
+} Process;
+
+// for ready list
+typedef struct Node {
+    Process* process; // a pointer to a process
+    struct Node* next;
+} Node;
+
+// ready list (linked list)
+typedef struct RL {
+    Node* head;
+    Node* tail;
+    int size;       // queued nodes
+    Node* pool;     // removed nodes kept for reuse
+    int pooled;     // nodes in pool
+} RL;
+
+// streaming trace-event export
+typedef struct Trace {
+    FILE* stream;
+    int64_t events;     // events written
+    int process;        // trace process of the current run (one per run)
+    int tracks;         // cpu tracks named in the current run
+} Trace;
+
+// gantt timeline (grows as slices are added)
+typedef struct Gantt {
+    int* pid;       // pid of each slice (idle = -1)
+    int64_t* start; // slice start
+    int64_t* end;   // slice end
+    int size;
+    int capacity;
+    Trace* trace;   // slices are also streamed here (NULL = none)
+    int cpu;        // cpu the timeline belongs to (trace track)
+    bool discard;   // slices only go to trace, the timeline stays empty
+} Gantt;
+
+// scheduling policy driven by the simulation engine
+typedef struct Policy {
+    const char* name;
+    bool (*enqueue)(RL* rl, Process* p);            // add an arrived or preempted process to RL
+    Process* (*pickNext)(RL* rl);                   // remove the next process to run from RL
+    bool (*preempt)(Process* running, Process* arrival);    // on-arrival preemption hook (NULL = none)
+    int64_t quantum;                                // time slice length (0 = run to completion)
+    bool job_quanta;                                // processes with their own quantum > 0 use it instead
+} Policy;
+
+// simulation state (everything besides processes, RL and gantt needed to resume a run)
+typedef struct Sim {
+    int64_t time;
+    int completed;
+    int next;               // index of next process to arrive
+    Process* p;             // running process
+    int64_t slice_start;    // time running process was dispatched
+    int64_t slice_left;     // time left in running process's quantum
+} Sim;
+
+// multi-cpu settings and a run's migration stats
+typedef struct Machine {
+    int num_cpus;
+    int64_t migration_cost; // penalty for resuming on another cpu than last time
+    int64_t cold_cost;      // penalty for resuming on the same cpu after another process ran there
+    bool affinity;          // dispatch to a process's last cpu when it's free
+
+    // results of the last run
+    int64_t migrations;
+    int64_t cold_restarts;
+    int64_t penalty;        // cpu time lost to penalties
+} Machine;
+
+// a cpu in a multi-cpu run
+typedef struct Cpu {
+    Process* p;             // running process (NULL = free)
+    Process* last;          // last process run (still warm in cache)
+    int64_t slice_start;
+    int64_t slice_left;     // time left in running process's quantum
+    int64_t stall;          // penalty time left before the process makes progress
+    int64_t free_since;     // time the cpu went idle
+    Timer timer;            // completion/quantum expiry of running process
+} Cpu;
+
+// early termination for tuning runs
+typedef struct Bound {
+    SchedObjective objective;
+    double switch_weight;   // cost per context switch per process
+    double limit;           // stop once the run's cost must exceed this
+    bool exceeded;          // run was stopped early
+    int64_t dispatches;     // context switches so far
+    double total_waiting;   // waiting of finished processes (avg objective)
+    int over;               // finished processes waiting past the limit (p99 objective)
+} Bound;
+
+// round robin quantum search
+typedef struct Tuning {
+    SchedObjective objective;
+    double switch_weight;
+    int64_t quantum;        // best quantum found
+    double cost;            // its cost
+    int runs;               // simulations run
+    int cut_short;          // simulations stopped early
+} Tuning;
+
+// one telemetry sample
+typedef struct Sample {
+    int64_t time;
+    int ready;              // ready list depth
+    int running;            // running pid (-1 = idle)
+    int64_t busy;           // cpu busy time so far
+    int64_t idle;           // cpu idle time so far
+} Sample;
+
+// sampled time series recorder
+typedef struct Telemetry {
+    int64_t interval;       // time between samples
+    Sample* ring;           // last capacity samples (preallocated)
+    int capacity;
+    FILE* stream;           // every sample as csv (NULL = none)
+
+    // current run
+    const char* policy;
+    int64_t next;           // time of next sample
+    int64_t count;          // samples taken
+    int64_t first;          // samples taken before a resume (not kept)
+    int64_t busy;
+    int64_t idle;
+} Telemetry;
+
+// processes parsed on another thread, handed over in arrival-ordered batches
+typedef struct ArrivalSource {
+    Process** processes;    // preallocated slots, filled in file order
+    int num_processes;      // lines to parse
+    FILE* file;
+    pthread_t thread;       // parser
+
+    // single-producer/single-consumer ring of batch end indices
+    int ends[SOURCE_RING_SIZE];
+    unsigned head;          // batches published (parser)
+    unsigned tail;          // batches taken (simulator)
+    bool unsorted;          // a line was out of arrival/pid order
+    bool parsed;            // parser has published its last batch
+
+    int loaded;             // processes taken by the simulator
+} ArrivalSource;
+
+// monte carlo replica metrics
+typedef enum ReplicaMetric {
+    REPLICA_WAITING,
+    REPLICA_TURNAROUND,
+    REPLICA_THROUGHPUT,
+    NUM_REPLICA_METRICS,
+} ReplicaMetric;
+
+// monte carlo replica settings and samples
+typedef struct Replicas {
+    int count;
+    uint64_t seed;
+    int64_t jitter;         // max arrival shift either way
+    int num_threads;        // 0 = one per cpu
+    int64_t quantum;        // round robin quantum for processes without their own
+    unsigned policies;      // bit k set = run POLICIES[k]
+    double* samples;        // metrics per replica and policy
+} Replicas;
+
+// snapshot of a simulation in progress (header is written as-is, followed by the arrays)
+typedef struct Checkpoint {
+    char magic[4];
+    int version;
+    char policy[16];
+    int64_t quantum;
+    int num_processes;
+    unsigned long long input_hash;
+    int64_t time;
+    int completed;
+    int next;
+    int running;        // index of running process (-1 = none)
+    int64_t slice_start;
+    int64_t slice_left;
+    int num_ready;
+    int num_slices;
+
+    // variable-length data
+    int* ready;         // RL contents from head (process indices)
+    int64_t* jobs;      // remaining/start/complete of each admitted process
+    int64_t* slices;    // pid/start/end of each gantt slice
+} Checkpoint;
+
+// checkpoint settings of a run
+typedef struct Checkpointing {
+    const char* path;       // snapshot file (NULL = no checkpoints)
+    double interval;        // min seconds between snapshots
+    Checkpoint* resume;     // snapshot to resume from (freed once restored)
+} Checkpointing;
+
+// in-memory snapshot of a run for incremental re-simulation (only what the
+// run's results don't already hold: processes finished and slices added
+// before the snapshot are final)
+typedef struct Snapshot {
+    int64_t time;
+    int completed;
+    int next;
+    int running;            // index of running process (-1 = none)
+    int64_t slice_start;
+    int64_t slice_left;
+    int num_slices;         // gantt slices so far
+    int num_ready;
+    int* ready;             // RL contents from head (process indices)
+    int64_t* jobs;          // remaining/start of each ready process, then the running one
+} Snapshot;
+
+// snapshots taken during a run
+typedef struct History {
+    int interval;           // admitted processes between snapshots (0 = none)
+    int next_at;            // admitted processes at the next snapshot
+    Snapshot* snapshots;    // in time order
+    int count;
+    int capacity;
+    Snapshot* resume;       // snapshot the run starts from (NULL = time 0)
+} History;
+
+// built-in policies
+extern const Policy POLICIES[];
+extern const int NUM_POLICIES;
+
+// FUNCTION PROTOTYPES
+void fcfs(RL* rl, Process** processes, int num_processes);
+void sjf(RL* rl, Process** processes, int num_processes);
+void ps(RL* rl, Process** processes, int num_processes);
+void rr(RL* rl, Process** processes, int num_processes, int64_t quantum);
+void tuneRr(RL* rl, Process** processes, int num_processes, Tuning* tuning);
+void runReplicaMode(Process** processes, int num_processes, Replicas* replicas);
+unsigned parsePolicies(const char* list);
+void runPolicy(const Policy* policy, RL* rl, Process** processes, int num_processes);
+void endTrace();
+const Policy* findPolicy(const char* name);
+
+SchedStatus simulate(const Policy* policy, RL* rl, Process** processes, int num_processes, Gantt* gantt, int64_t* end_time);
+SchedStatus simulateWith(const Policy* policy, RL* rl, Process** processes, int num_processes, Gantt* gantt, \
+    int64_t* end_time, Bound* bound, Telemetry* telemetry, ArrivalSource* source, History* history, \
+    Checkpointing* checkpointing);
+SchedStatus loadArrivals(ArrivalSource* source, Wheel* wheel, Timer* arrivals, int next, int64_t time);
+bool exceedsBound(Bound* bound, Process* finished, int num_processes);
+int p99Rank(int num_processes);
+void admitArrivals(const Policy* policy, RL* rl, Wheel* wheel, int* next, int64_t time);
+Process* dispatchNext(const Policy* policy, RL* rl, int64_t time, int64_t* slice_left);
+int64_t runEnd(const Policy* policy, Process* p, int64_t slice_left, int64_t time);
+bool finishProcess(Gantt* gantt, Process* p, int64_t slice_start, int64_t time);
+bool expireQuantum(const Policy* policy, RL* rl, Wheel* wheel, int* next, Gantt* gantt, Process* p, \
+    int64_t slice_start, int64_t time);
+bool preemptProcess(const Policy* policy, RL* rl, Wheel* wheel, Timer* run_timer, Gantt* gantt, Process* p, \
+    int64_t slice_start, int64_t time);
+bool requeueProcess(const Policy* policy, RL* rl, Gantt* gantt, Process* p, int64_t slice_start, int64_t time, \
+    const char* reason);
+bool checkPreemption(const Policy* policy, Process* p, Process** processes, int num_processes, int next, int64_t time);
+bool preemptShorter(Process* running, Process* arrival);
+void printSchedule(FILE* out, const char* name, Process** processes, int num_processes, Gantt* gantts, int num_gantts, \
+    int64_t time, Machine* machine);
+
+SchedStatus simulateCpus(const Policy* policy, RL* rl, Process** processes, int num_processes, Gantt* gantts, \
+    int64_t* end_time, Machine* machine);
+int pickCpu(Machine* machine, Cpu* cpus, Process* p);
+int64_t dispatchPenalty(Machine* machine, Cpu* cpus, int c, Process* p);
+
+SchedStatus tuneQuantum(RL* rl, Process** processes, int num_processes, Tuning* tuning);
+SchedStatus tryQuantum(RL* rl, Process** processes, int num_processes, int64_t quantum, Tuning* tuning, \
+    Gantt* gantt, int64_t* waiting);
+
+SchedStatus saveCheckpoint(const char* path, const Policy* policy, RL* rl, Process** processes, int num_processes, Sim* sim, Gantt* gantt);
+SchedStatus loadCheckpoint(const char* path, Checkpoint** out);
+SchedStatus restoreCheckpoint(Checkpoint* ckpt, const Policy* policy, RL* rl, Process** processes, int num_processes, Sim* sim, Gantt* gantt);
+void freeCheckpoint(Checkpoint* ckpt);
+unsigned long long hashInput(Process** processes, int num_processes);
+double wallTime();
+
+void initHistory(History* history, int interval);
+bool takeSnapshot(History* history, RL* rl, Sim* sim, Gantt* gantt);
+bool copySnapshot(History* history, const Snapshot* snapshot);
+bool restoreSnapshot(Snapshot* snapshot, RL* rl, Process** processes, Sim* sim);
+void freeHistory(History* history);
+
+bool initGantt(Gantt* gantt, int capacity);
+bool addSlice(Gantt* gantt, int pid, int64_t start, int64_t end);
+void resetGantt(Gantt* gantt);
+void freeGantt(Gantt* gantt);
+
+int processDiff(const void *p1, const void *p2);
+int timeDiff(const void *t1, const void *t2);
+bool sortProcesses(Process** processes, int num_processes);
+bool parseProcess(const char* ln, Process* p);
+void printProcesses(Process** processes, int num_processes);
+bool validWorkload(Process** processes, int num_processes);
+Process* findProcess(Process** processes, int num_processes, int pid);
+uint64_t nextRandom(uint64_t* rng);
+int64_t randomRange(uint64_t* rng, int64_t lo, int64_t hi);
+
+void initRL(RL* rl);
+void clearRL(RL* rl);
+void freeRL(RL* rl);
+bool reserveNodes(RL* rl, int num_nodes);
+Node* newNode(RL* rl);
+void releaseNode(RL* rl, Node* node);
+bool addNode(RL* rl, Process* p);
+bool addNodeRR(RL* rl, Process* p);
+Process* removeNode(RL* rl);
+Process* removeNodePriority(RL* rl);
+int isEmpty(RL* rl);
+void printList(RL* rl);
+void wipeProcessTimes(Process** processes, int num_processes);
+
+int serve(const char* socket_path, int num_workers);
+
+bool initTelemetry(Telemetry* telemetry, int64_t interval, int capacity, FILE* stream);
+void startTelemetry(Telemetry* telemetry, const char* policy, Sim* sim, Gantt* gantt);
+void recordTelemetry(Telemetry* telemetry, Process** processes, int num_processes, int next, int ready, int pid, \
+    int64_t from, int64_t to);
+void printTelemetry(FILE* out, Telemetry* telemetry);
+void freeTelemetry(Telemetry* telemetry);
+
+void openTrace(Trace* trace, FILE* stream);
+void startTrace(Trace* trace, const char* policy);
+void traceSlice(Trace* trace, int cpu, int pid, int64_t start, int64_t end);
+void traceMark(Trace* trace, int cpu, const char* reason, int pid, int64_t time);
+void closeTrace(Trace* trace);
+
+bool startSource(ArrivalSource* source, FILE* file, Process** processes, int num_processes);
+int nextBatch(ArrivalSource* source);
+void finishSource(ArrivalSource* source);
+
+SchedStatus runReplicas(Process** processes, int num_processes, Replicas* replicas);
+double* replicaSample(Replicas* replicas, int r, int k);
+void replicaInterval(Replicas* replicas, int k, int metric, double* mean, double* half_width);
+void printReplicas(FILE* out, Replicas* replicas);
+void freeReplicas(Replicas* replicas);
+
+#endif
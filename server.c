@@ -0,0 +1,394 @@
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "schedule.h"
+
+// daemon mode: answers workloads over a unix domain socket so callers skip
+// process startup, file i/o and allocation on every run
+//
+// request:  RUN <fcfs|sjf|ps|rr|all> <csv|bin> <payload bytes> [quantum]\n<payload>
+// response: OK <report bytes>\n<report>   or   ERROR <message>\n
+//
+// csv payloads are input file lines; bin payloads are 32-byte host-order
+// records: int32 pid, int32 priority, int64 arrival, int64 burst, int64 quantum
+// (quantum defaults to the earliest arrival's, as on the command line)
+
+const int SERVER_BACKLOG = 64;
+const int BINARY_RECORD_SIZE = 32;
+const size_t MAX_PAYLOAD = (size_t) 1 << 31;
+
+// per-worker memory kept warm between requests
+typedef struct Workspace {
+    Process* storage;       // process records
+    Process** processes;    // pointers into storage (sorted per request)
+    int capacity;
+    char* payload;          // request payload buffer
+    size_t payload_capacity;
+    RL rl;                  // ready list (keeps its node pool)
+    Gantt gantt;            // gantt timeline (keeps its capacity)
+} Workspace;
+
+// worker thread arguments
+typedef struct Worker {
+    pthread_t thread;
+    int listen_fd;
+} Worker;
+
+// FUNCTION PROTOTYPES
+void* workerLoop(void* arg);
+void handleConnection(Workspace* ws, int fd);
+const char* runRequest(Workspace* ws, const char* policy_name, const char* format, size_t length, \
+    bool has_quantum, int64_t quantum, FILE* out);
+const char* loadCsv(Workspace* ws, size_t length, int* num_processes);
+const char* loadBinary(Workspace* ws, size_t length, int* num_processes);
+bool reserveProcesses(Workspace* ws, int num_processes);
+bool writeAll(int fd, const char* buf, size_t length);
+void sendError(int fd, const char* message);
+
+// listen on socket_path and serve requests on num_workers threads (0 = one
+// per cpu); only returns on setup errors
+int serve(const char* socket_path, int num_workers) {
+
+    // default to one worker per cpu
+    if (num_workers <= 0) {
+        num_workers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_workers <= 0) {
+            num_workers = 1;
+        }
+    }
+
+    // clients hanging up mid-response shouldn't kill the daemon
+    signal(SIGPIPE, SIG_IGN);
+
+    // create socket (replacing a stale one)
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        printf("ERROR socket path too long\n");
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+    unlink(socket_path);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr*) &addr, sizeof(addr)) != 0 || \
+    listen(listen_fd, SERVER_BACKLOG) != 0) {
+        printf("ERROR opening socket %s\n", socket_path);
+        return 1;
+    }
+
+    fprintf(stderr, "Serving on %s with %d workers\n", socket_path, num_workers);
+
+    // start worker pool (each worker accepts its own connections)
+    Worker* workers = (Worker*) malloc(num_workers * sizeof(Worker));
+    if (workers == NULL) {
+        printf("ERROR allocating memory for workers\n");
+        return 1;
+    }
+    for (int i = 0; i < num_workers; i++) {
+        workers[i].listen_fd = listen_fd;
+        if (pthread_create(&workers[i].thread, NULL, workerLoop, &workers[i]) != 0) {
+            printf("ERROR starting worker thread\n");
+            return 1;
+        }
+    }
+
+    // workers run until the process is killed
+    for (int i = 0; i < num_workers; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    close(listen_fd);
+    unlink(socket_path);
+    free(workers);
+
+    return 0;
+}
+
+// accept and answer connections with a workspace that stays warm
+void* workerLoop(void* arg) {
+
+    Worker* worker = (Worker*) arg;
+
+    // workspace starts empty and grows to the largest request seen
+    Workspace ws;
+    memset(&ws, 0, sizeof(ws));
+    initRL(&ws.rl);
+    if (!initGantt(&ws.gantt, 64)) {
+        fprintf(stderr, "ERROR allocating memory for worker\n");
+        return NULL;
+    }
+
+    while (true) {
+        int fd = accept(worker->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            continue;
+        }
+        handleConnection(&ws, fd);
+        close(fd);
+    }
+
+    return NULL;
+}
+
+// answer requests on a connection until the client closes it
+void handleConnection(Workspace* ws, int fd) {
+
+    // buffered reader on the connection
+    int read_fd = dup(fd);
+    FILE* in = (read_fd < 0) ? NULL : fdopen(read_fd, "r");
+    if (in == NULL) {
+        if (read_fd >= 0) {
+            close(read_fd);
+        }
+        sendError(fd, "out of resources");
+        return;
+    }
+
+    char header[256];
+    while (fgets(header, sizeof(header), in) != NULL) {
+
+        // parse header
+        char command[8], policy_name[16], format[8];
+        unsigned long long length;
+        long long quantum = 0;
+        int fields = sscanf(header, "%7s %15s %7s %llu %lld", command, policy_name, format, &length, &quantum);
+        if (fields < 4 || strcmp(command, "RUN") != 0) {
+            sendError(fd, "bad request header");
+            break;
+        }
+        if (length > MAX_PAYLOAD) {
+            sendError(fd, "payload too large");
+            break;
+        }
+
+        // read payload into workspace buffer
+        if (length + 1 > ws->payload_capacity) {
+            char* payload = (char*) realloc(ws->payload, length + 1);
+            if (payload == NULL) {
+                sendError(fd, "out of memory");
+                break;
+            }
+            ws->payload = payload;
+            ws->payload_capacity = length + 1;
+        }
+        if (fread(ws->payload, 1, length, in) != length) {
+            break;
+        }
+        ws->payload[length] = '\0';
+
+        // run workload, collecting report in memory
+        char* report = NULL;
+        size_t report_length = 0;
+        FILE* out = open_memstream(&report, &report_length);
+        if (out == NULL) {
+            sendError(fd, "out of memory");
+            break;
+        }
+        const char* error = runRequest(ws, policy_name, format, (size_t) length, fields == 5, quantum, out);
+        fclose(out);
+
+        // send response
+        if (error != NULL) {
+            sendError(fd, error);
+        } else {
+            char status[32];
+            int status_length = snprintf(status, sizeof(status), "OK %zu\n", report_length);
+            if (!writeAll(fd, status, status_length) || !writeAll(fd, report, report_length)) {
+                free(report);
+                break;
+            }
+        }
+        free(report);
+    }
+
+    fclose(in);
+}
+
+// load payload and run the selected policies, writing their reports to out;
+// returns an error message or NULL
+const char* runRequest(Workspace* ws, const char* policy_name, const char* format, size_t length, \
+    bool has_quantum, int64_t quantum, FILE* out) {
+
+    // load workload
+    int num_processes = 0;
+    const char* error;
+    if (strcmp(format, "csv") == 0) {
+        error = loadCsv(ws, length, &num_processes);
+    } else if (strcmp(format, "bin") == 0) {
+        error = loadBinary(ws, length, &num_processes);
+    } else {
+        error = "unknown format";
+    }
+    if (error != NULL) {
+        return error;
+    }
+    if (num_processes == 0) {
+        return "empty workload";
+    }
+    if (!validWorkload(ws->processes, num_processes)) {
+        return "negative or overflowing arrival/burst";
+    }
+
+    // check policy
+    bool all = (strcasecmp(policy_name, "all") == 0);
+    if (!all && findPolicy(policy_name) == NULL) {
+        return "unknown policy";
+    }
+
+    // sort once for all policies
+    if (!sortProcesses(ws->processes, num_processes)) {
+        return "out of memory";
+    }
+    if (!has_quantum) {
+        quantum = ws->processes[0]->quantum;
+    }
+
+    // run selected policies
+    for (int i = 0; i < NUM_POLICIES; i++) {
+
+        Policy policy = POLICIES[i];
+        if (!all && strcasecmp(policy_name, policy.name) != 0) {
+            continue;
+        }
+
+        // only round robin takes a quantum
+        if (strcmp(policy.name, "RR") == 0) {
+            if (quantum <= 0) {
+                return "invalid quantum";
+            }
+            policy.quantum = quantum;
+        }
+
+        resetGantt(&ws->gantt);
+        int64_t time;
+        SchedStatus status = simulate(&policy, &ws->rl, ws->processes, num_processes, &ws->gantt, &time);
+        if (status != SCHED_OK) {
+            return schedStatusMessage(status);
+        }
+        printSchedule(out, policy.name, ws->processes, num_processes, &ws->gantt, 1, time, NULL);
+    }
+
+    return NULL;
+}
+
+// parse csv payload lines into workspace processes
+const char* loadCsv(Workspace* ws, size_t length, int* num_processes) {
+
+    // count lines to size the workspace
+    int num_lines = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (ws->payload[i] == '\n') {
+            num_lines++;
+        }
+    }
+    if (!reserveProcesses(ws, num_lines)) {
+        return "out of memory";
+    }
+
+    // parse non-empty lines
+    int j = 0;
+    char* save = NULL;
+    for (char* ln = strtok_r(ws->payload, "\r\n", &save); ln != NULL; ln = strtok_r(NULL, "\r\n", &save)) {
+        if (!parseProcess(ln, &ws->storage[j])) {
+            return "bad csv record";
+        }
+        ws->processes[j] = &ws->storage[j];
+        j++;
+    }
+
+    *num_processes = j;
+
+    return NULL;
+}
+
+// decode binary payload records into workspace processes
+const char* loadBinary(Workspace* ws, size_t length, int* num_processes) {
+
+    if (length % BINARY_RECORD_SIZE != 0) {
+        return "bad binary payload length";
+    }
+
+    int num_records = (int) (length / BINARY_RECORD_SIZE);
+    if (!reserveProcesses(ws, num_records)) {
+        return "out of memory";
+    }
+
+    for (int j = 0; j < num_records; j++) {
+
+        // unpack record fields
+        const char* record = ws->payload + (size_t) j * BINARY_RECORD_SIZE;
+        Process* p = &ws->storage[j];
+        int32_t pid, priority;
+        memcpy(&pid, record, 4);
+        memcpy(&priority, record + 4, 4);
+        memcpy(&p->arrival, record + 8, 8);
+        memcpy(&p->burst, record + 16, 8);
+        memcpy(&p->quantum, record + 24, 8);
+        p->pid = pid;
+        p->priority = priority;
+
+        // set engineered process info
+        p->remaining = p->burst;
+        p->waiting = 0;
+        p->turnaround = 0;
+        p->start = 0;
+        p->complete = 0;
+        p->finished = false;
+        p->visited = false;
+
+        ws->processes[j] = p;
+    }
+
+    *num_processes = num_records;
+
+    return NULL;
+}
+
+// grow workspace process storage to hold num_processes
+bool reserveProcesses(Workspace* ws, int num_processes) {
+
+    if (num_processes <= ws->capacity) {
+        return true;
+    }
+
+    Process* storage = (Process*) realloc(ws->storage, num_processes * sizeof(Process));
+    if (storage == NULL) {
+        return false;
+    }
+    ws->storage = storage;
+
+    Process** processes = (Process**) realloc(ws->processes, num_processes * sizeof(Process*));
+    if (processes == NULL) {
+        return false;
+    }
+    ws->processes = processes;
+    ws->capacity = num_processes;
+
+    return true;
+}
+
+// write a whole buffer to a socket
+bool writeAll(int fd, const char* buf, size_t length) {
+
+    while (length > 0) {
+        ssize_t written = write(fd, buf, length);
+        if (written <= 0) {
+            return false;
+        }
+        buf += written;
+        length -= written;
+    }
+
+    return true;
+}
+
+// send an error response
+void sendError(int fd, const char* message) {
+    char response[128];
+    int length = snprintf(response, sizeof(response), "ERROR %s\n", message);
+    writeAll(fd, response, length);
+}
@@ -0,0 +1,49 @@
+#ifdef SCHED_STATS
+
+#include <stdio.h>
+#include <time.h>
+#include "stats.h"
+
+// GLOBAL VARIABLES
+Stats stats;
+
+// names of phases for the summary
+static const char* PHASE_NAMES[NUM_PHASES] = { "parse", "sort", "simulate", "report" };
+
+// read a clock in seconds
+static double readClock(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// start timing a phase
+void phaseBegin(Phase phase) {
+    stats.wall_start[phase] = readClock(CLOCK_MONOTONIC);
+    stats.cpu_start[phase] = readClock(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+// stop timing a phase and add the interval to its total
+void phaseEnd(Phase phase) {
+    stats.wall[phase] += readClock(CLOCK_MONOTONIC) - stats.wall_start[phase];
+    stats.cpu[phase] += readClock(CLOCK_PROCESS_CPUTIME_ID) - stats.cpu_start[phase];
+}
+
+// print summary of phase times and counters (stderr, keeps stdout report intact)
+void printStats() {
+
+    fprintf(stderr, "\n---------------------------- STATS ----------------------------\n");
+    fprintf(stderr, "\tPhase\t\t|\tWall (s)\t|\tCPU (s)\n");
+    for (int i = 0; i < NUM_PHASES; i++) {
+        fprintf(stderr, "\t%-8s\t|\t%.6f\t|\t%.6f\n", PHASE_NAMES[i], stats.wall[i], stats.cpu[i]);
+    }
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "RL inserts: %lld\n", stats.rl_inserts);
+    fprintf(stderr, "RL removals: %lld\n", stats.rl_removals);
+    fprintf(stderr, "RL walk steps: %lld\n", stats.walk_steps);
+    fprintf(stderr, "Allocations: %lld\n", stats.allocations);
+    fprintf(stderr, "Events: %lld\n\n", stats.events);
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef STATS_H
+#define STATS_H
+
+// self-profiling counters and phase timers; only built with -DSCHED_STATS
+// (make stats), otherwise every macro below compiles to nothing
+
+// profiled phases
+typedef enum Phase {
+    PHASE_PARSE,
+    PHASE_SORT,
+    PHASE_SIMULATE,
+    PHASE_REPORT,
+    NUM_PHASES
+} Phase;
+
+// hot-path counters and accumulated phase times
+typedef struct Stats {
+    long long rl_inserts;       // addNode/addNodeRR calls
+    long long rl_removals;      // removeNode/removeNodePriority calls
+    long long walk_steps;       // list nodes stepped over in addNode/addNodeRR
+    long long allocations;      // malloc/calloc/realloc calls
+    long long events;           // simulation loop iterations
+
+    double wall[NUM_PHASES];        // wall seconds per phase
+    double cpu[NUM_PHASES];         // cpu seconds per phase
+    double wall_start[NUM_PHASES];  // start of the open interval per phase
+    double cpu_start[NUM_PHASES];
+} Stats;
+
+#ifdef SCHED_STATS
+
+extern Stats stats;
+
+#define STAT_INC(counter) (stats.counter++)
+#define STAT_ADD(counter, n) (stats.counter += (n))
+#define PHASE_BEGIN(phase) phaseBegin(phase)
+#define PHASE_END(phase) phaseEnd(phase)
+#define STATS_ENABLED 1
+
+// STATS FUNCTION PROTOTYPES
+void phaseBegin(Phase phase);
+void phaseEnd(Phase phase);
+void printStats();
+
+#else
+
+#define STAT_INC(counter) ((void) 0)
+#define STAT_ADD(counter, n) ((void) 0)
+#define PHASE_BEGIN(phase) ((void) 0)
+#define PHASE_END(phase) ((void) 0)
+#define STATS_ENABLED 0
+
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+#include "schedule.h"
+
+// sampled time series of ready list depth, running pid and cumulative cpu
+// busy/idle time; the engine jumps from event to event, so each jump records
+// every sample time it passes over (state is constant in between)
+
+// set up a telemetry recorder keeping the last capacity samples (0 = none)
+// and/or streaming every sample to stream (NULL = none); false if out of memory
+bool initTelemetry(Telemetry* telemetry, int64_t interval, int capacity, FILE* stream) {
+
+    memset(telemetry, 0, sizeof(Telemetry));
+    telemetry->interval = interval;
+    telemetry->capacity = capacity;
+    telemetry->stream = stream;
+
+    // preallocate ring
+    if (capacity > 0) {
+        telemetry->ring = (Sample*) malloc(capacity * sizeof(Sample));
+        if (telemetry->ring == NULL) {
+            return false;
+        }
+    }
+
+    // csv header
+    if (stream != NULL) {
+        fprintf(stream, "policy,time,ready,running,busy,idle\n");
+    }
+
+    return true;
+}
+
+// start a new run's series at sim's time (first sample on the next interval
+// boundary); a resumed run's sample count and busy/idle counters pick up the
+// time before it, from gantt's slices and the running process's open slice
+void startTelemetry(Telemetry* telemetry, const char* policy, Sim* sim, Gantt* gantt) {
+
+    int64_t time = sim->time;
+    telemetry->policy = policy;
+    telemetry->busy = (sim->p != NULL) ? time - sim->slice_start : 0;
+    for (int i = 0; i < gantt->size; i++) {
+        if (gantt->pid[i] != -1) {
+            telemetry->busy += gantt->end[i] - gantt->start[i];
+        }
+    }
+    telemetry->idle = time - telemetry->busy;
+
+    // round time up to a multiple of interval
+    int64_t offset = time % telemetry->interval;
+    if (offset < 0) {
+        offset += telemetry->interval;
+    }
+    telemetry->next = (offset == 0) ? time : time + (telemetry->interval - offset);
+
+    // runs start at time 0, so every boundary before next was sampled already
+    telemetry->count = telemetry->next / telemetry->interval;
+    telemetry->first = telemetry->count;
+}
+
+// record the samples in [from, to) while pid runs (-1 = idle) with ready
+// processes queued, counting processes from next on that arrive by each
+// sample time as ready too (the engine admits them at the next event)
+void recordTelemetry(Telemetry* telemetry, Process** processes, int num_processes, int next, int ready, int pid, \
+    int64_t from, int64_t to) {
+
+    // take samples in this stretch
+    int arrived = next;
+    for (; telemetry->next < to; telemetry->next += telemetry->interval) {
+
+        while (arrived < num_processes && processes[arrived]->arrival <= telemetry->next) {
+            arrived++;
+        }
+
+        int64_t elapsed = telemetry->next - from;
+        Sample sample = {
+            telemetry->next,
+            ready + (arrived - next),
+            pid,
+            telemetry->busy + ((pid == -1) ? 0 : elapsed),
+            telemetry->idle + ((pid == -1) ? elapsed : 0),
+        };
+
+        // keep in ring (oldest overwritten) and stream
+        if (telemetry->capacity > 0) {
+            telemetry->ring[telemetry->count % telemetry->capacity] = sample;
+        }
+        if (telemetry->stream != NULL) {
+            fprintf(telemetry->stream, "%s,%" PRId64 ",%d,%d,%" PRId64 ",%" PRId64 "\n", \
+                telemetry->policy, sample.time, sample.ready, sample.running, sample.busy, sample.idle);
+        }
+        telemetry->count++;
+    }
+
+    // accumulate cpu time
+    if (pid == -1) {
+        telemetry->idle += to - from;
+    } else {
+        telemetry->busy += to - from;
+    }
+}
+
+// print the samples kept in the ring (oldest first)
+void printTelemetry(FILE* out, Telemetry* telemetry) {
+
+    int64_t taken = telemetry->count - telemetry->first;
+    int64_t kept = (taken < telemetry->capacity) ? taken : telemetry->capacity;
+
+    fprintf(out, "Telemetry (every %" PRId64 ", last %" PRId64 " of %" PRId64 " samples):\n", \
+        telemetry->interval, kept, telemetry->count);
+    fprintf(out, "\tTime\t|\tReady\t|\tRunning\t|\tBusy\t|\tIdle\n");
+    for (int64_t i = telemetry->count - kept; i < telemetry->count; i++) {
+        Sample* sample = &telemetry->ring[i % telemetry->capacity];
+        if (sample->running == -1) {
+            fprintf(out, "\t%" PRId64 "\t|\t%d\t|\tIDLE\t|\t%" PRId64 "\t|\t%" PRId64 "\n", \
+                sample->time, sample->ready, sample->busy, sample->idle);
+        } else {
+            fprintf(out, "\t%" PRId64 "\t|\t%d\t|\t%d\t|\t%" PRId64 "\t|\t%" PRId64 "\n", \
+                sample->time, sample->ready, sample->running, sample->busy, sample->idle);
+        }
+    }
+    fprintf(out, "\n");
+}
+
+// free telemetry ring
+void freeTelemetry(Telemetry* telemetry) {
+    free(telemetry->ring);
+    telemetry->ring = NULL;
+    telemetry->capacity = 0;
+}
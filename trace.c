@@ -0,0 +1,70 @@
+#include "schedule.h"
+
+// chrome trace-event json export (chrome://tracing, ui.perfetto.dev): each
+// run is a trace process named after its policy with one track per simulated
+// cpu; slices are written as they're added, so nothing is kept in memory
+//
+// simulated time units are written as microseconds
+
+// write the trace header to stream
+void openTrace(Trace* trace, FILE* stream) {
+
+    memset(trace, 0, sizeof(Trace));
+    trace->stream = stream;
+
+    fprintf(stream, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+}
+
+// separate events (every event goes on its own line)
+static void nextEvent(Trace* trace) {
+    fprintf(trace->stream, trace->events == 0 ? "\n" : ",\n");
+    trace->events++;
+}
+
+// start a new run as a trace process named policy
+void startTrace(Trace* trace, const char* policy) {
+
+    trace->process++;
+    trace->tracks = 0;
+
+    nextEvent(trace);
+    fprintf(trace->stream, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"%s\"}}", \
+        trace->process, policy);
+}
+
+// name cpu tracks up to cpu the first time they're used
+static void useTrack(Trace* trace, int cpu) {
+    for (; trace->tracks <= cpu; trace->tracks++) {
+        nextEvent(trace);
+        fprintf(trace->stream, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"CPU %d\"}}", \
+            trace->process, trace->tracks, trace->tracks);
+    }
+}
+
+// write a slice (pid ran on cpu from start to end, idle pid = -1)
+void traceSlice(Trace* trace, int cpu, int pid, int64_t start, int64_t end) {
+
+    useTrack(trace, cpu);
+    nextEvent(trace);
+    if (pid == -1) {
+        fprintf(trace->stream, "{\"name\":\"IDLE\",\"cat\":\"idle\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d," \
+            "\"ts\":%" PRId64 ",\"dur\":%" PRId64 "}", trace->process, cpu, start, end - start);
+    } else {
+        fprintf(trace->stream, "{\"name\":\"%d\",\"cat\":\"run\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d," \
+            "\"ts\":%" PRId64 ",\"dur\":%" PRId64 ",\"args\":{\"pid\":%d}}", pid, trace->process, cpu, start, end - start, pid);
+    }
+}
+
+// write an instant event on cpu's track (pid was taken off the cpu at time for reason)
+void traceMark(Trace* trace, int cpu, const char* reason, int pid, int64_t time) {
+
+    useTrack(trace, cpu);
+    nextEvent(trace);
+    fprintf(trace->stream, "{\"name\":\"%s\",\"cat\":\"preempt\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d," \
+        "\"ts\":%" PRId64 ",\"args\":{\"pid\":%d}}", reason, trace->process, cpu, time, pid);
+}
+
+// write the trace footer (stream is left open)
+void closeTrace(Trace* trace) {
+    fprintf(trace->stream, "\n]}\n");
+}
@@ -0,0 +1,829 @@
+#include "schedule.h"
+
+// differential validation harness: runs the original tick-based schedulers
+// (reference) and the event-driven engine on randomized workloads, diffing
+// per-job waiting/turnaround and the gantt timeline
+
+// scheduler under test (reference implementation vs engine policy)
+typedef struct Variant {
+    const char* name;
+    int64_t (*reference)(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt);
+    Policy policy;
+    double reference_secs;  // accumulated runtime of each side
+    double engine_secs;
+} Variant;
+
+// FUNCTION PROTOTYPES
+int64_t refFcfs(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt);
+int64_t refSjf(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt);
+int64_t refPs(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt);
+int64_t refRr(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt);
+int64_t refRrJob(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt);
+int64_t refRoundRobin(RL* rl, Process** processes, int num_processes, int64_t quantum, bool job_quanta, Gantt* gantt);
+void refAddAllNodesRR(RL* rl, Process** processes, int num_processes, int64_t time);
+int ganttBound(Process** processes, int num_processes, int64_t quantum);
+void copyGantt(Gantt* gantt, int* gantt_pid, int64_t* gantt_start, int64_t* gantt_end, int gantt_i);
+
+int64_t generateWorkload(Process** processes, int num_processes, uint64_t* rng);
+bool compareRuns(const char* name, Process** processes, int num_processes, int64_t* waiting, int64_t* turnaround, \
+    Gantt* expected, Gantt* actual, int64_t expected_end, int64_t actual_end);
+void printWorkload(Process** processes, int num_processes);
+bool checkPipeline(RL* rl);
+bool checkWhatIf(Process** processes, int num_processes, int64_t quantum, uint64_t* rng, int* resumed);
+bool compareResults(const char* name, const SchedResult* what_if, const SchedResult* full);
+
+// REFERENCE SCHEDULERS (original tick-based implementations, output replaced by a gantt)
+
+// First-Come-First-Serve
+int64_t refFcfs(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt) {
+
+    // sort processes by arrival times (asc)
+    qsort(processes, num_processes, sizeof(Process*), processDiff);
+
+    // array to handle gantt timeline
+    int gantt_size = ganttBound(processes, num_processes, 0);
+    int gantt_pid[gantt_size];
+    int64_t gantt_start[gantt_size];
+    int64_t gantt_end[gantt_size];
+    int gantt_i = 0;
+
+    int64_t time = 0;
+
+    for (int i = 0; i < num_processes; i++) {
+
+        // handle idle time
+        if (processes[i]->arrival > time) {
+            gantt_pid[gantt_i] = -1;
+            gantt_start[gantt_i] = time;
+            time = processes[i]->arrival;
+            gantt_end[gantt_i++] = time;
+        }
+
+        gantt_pid[gantt_i] = processes[i]->pid;
+        gantt_start[gantt_i] = time;
+        processes[i]->start = time;
+        time += processes[i]->burst;
+        gantt_end[gantt_i++] = time;
+
+        processes[i]->turnaround = time - processes[i]->arrival;
+        processes[i]->waiting = processes[i]->turnaround - processes[i]->burst;
+        processes[i]->complete = time;
+    }
+
+    copyGantt(gantt, gantt_pid, gantt_start, gantt_end, gantt_i);
+
+    return time;
+}
+
+// Shortest-Remaining-Time
+int64_t refSjf(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt) {
+
+    wipeProcessTimes(processes, num_processes);
+    qsort(processes, num_processes, sizeof(Process*), processDiff);
+
+    // array to handle gantt timeline
+    int gantt_size = ganttBound(processes, num_processes, 0);
+    int gantt_pid[gantt_size];
+    int64_t gantt_start[gantt_size];
+    int64_t gantt_end[gantt_size];
+    int gantt_i = 0;
+    bool gantt_idle = false;
+
+    int64_t time = 0;
+    int completed = 0;
+    int curr_pid = -1;
+    Process* p = NULL;
+
+    while (completed < num_processes) {
+
+        // add processes to RL
+        for (int i = 0; i < num_processes; i++) {
+            if (processes[i]->arrival <= time && !processes[i]->finished && !processes[i]->visited) {
+                addNode(rl, processes[i]);
+                processes[i]->visited = true;
+            }
+        }
+
+        // handle process if RL not empty
+        if (curr_pid == -1 && !isEmpty(rl)) {
+
+            if (gantt_idle) {
+                gantt_idle = false;
+                gantt_end[gantt_i++] = time;
+            }
+
+            p = removeNode(rl);
+            curr_pid = p->pid;
+
+            gantt_pid[gantt_i] = p->pid;
+            gantt_start[gantt_i] = time;
+        }
+
+        // run current pid for 1 time unit
+        if (curr_pid != -1) {
+
+            time++;
+            p->remaining -= 1;
+
+            if (p->remaining == 0) {
+
+                p->finished = true;
+                curr_pid = -1;
+                p->complete = time;
+                p->turnaround = time - p->arrival;
+                p->waiting = p->turnaround - p->burst;
+                gantt_end[gantt_i++] = time;
+                completed++;
+
+            } else {
+
+                // check if preemption available
+                for (int i = 0; i < num_processes; i++) {
+                    if (processes[i]->arrival <= time && !processes[i]->finished && !processes[i]->visited && \
+                    processes[i]->remaining < p->remaining)
+                    {
+                        addNode(rl, p);
+                        gantt_end[gantt_i++] = time;
+                        curr_pid = -1;
+                        break;
+                    }
+                }
+            }
+
+        // idle
+        } else {
+
+            if (!gantt_idle) {
+                gantt_start[gantt_i] = time;
+                gantt_pid[gantt_i] = -1;
+            }
+            gantt_idle = true;
+            time++;
+        }
+    }
+
+    copyGantt(gantt, gantt_pid, gantt_start, gantt_end, gantt_i);
+
+    return time;
+}
+
+// Priority Scheduling (w/o preemption)
+int64_t refPs(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt) {
+
+    wipeProcessTimes(processes, num_processes);
+    qsort(processes, num_processes, sizeof(Process*), processDiff);
+
+    // array to handle gantt timeline
+    int gantt_size = ganttBound(processes, num_processes, 0);
+    int gantt_pid[gantt_size];
+    int64_t gantt_start[gantt_size];
+    int64_t gantt_end[gantt_size];
+    int gantt_i = 0;
+    bool gantt_idle = false;
+
+    int64_t time = 0;
+    int completed = 0;
+
+    while (completed < num_processes) {
+
+        // find arrived process with the highest priority
+        int top_priority = 100000;
+        int top_i = -1;
+        for (int i = 0; i < num_processes; i++) {
+            if (processes[i]->arrival <= time && !processes[i]->finished) {
+                if (processes[i]->priority < top_priority) {
+                    top_priority = processes[i]->priority;
+                    top_i = i;
+                }
+            }
+        }
+
+        if (top_i != -1) {
+
+            if (gantt_idle) {
+                gantt_end[gantt_i++] = time;
+                gantt_idle = false;
+            }
+
+            Process* p = processes[top_i];
+
+            gantt_pid[gantt_i] = p->pid;
+            gantt_start[gantt_i] = time;
+            completed++;
+            p->start = time;
+            time += p->burst;
+            p->complete = time;
+            p->turnaround = time - p->arrival;
+            p->waiting = p->turnaround - p->burst;
+            p->finished = true;
+            gantt_end[gantt_i++] = time;
+
+        // if no process, idle
+        } else {
+
+            if (!gantt_idle) {
+                gantt_start[gantt_i] = time;
+            }
+            gantt_pid[gantt_i] = -1;
+            gantt_idle = true;
+            time++;
+        }
+    }
+
+    copyGantt(gantt, gantt_pid, gantt_start, gantt_end, gantt_i);
+
+    return time;
+}
+
+// Round Robin
+int64_t refRr(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt) {
+    return refRoundRobin(rl, processes, num_processes, quantum, false, gantt);
+}
+
+// Round Robin, processes with their own quantum > 0 using it
+int64_t refRrJob(RL* rl, Process** processes, int num_processes, int64_t quantum, Gantt* gantt) {
+    return refRoundRobin(rl, processes, num_processes, quantum, true, gantt);
+}
+
+// round robin with quantum, or each process's own quantum (if > 0) with job_quanta
+int64_t refRoundRobin(RL* rl, Process** processes, int num_processes, int64_t quantum, bool job_quanta, Gantt* gantt) {
+
+    wipeProcessTimes(processes, num_processes);
+    qsort(processes, num_processes, sizeof(Process*), processDiff);
+
+    int64_t time = 0;
+    int completed = 0;
+
+    // array to handle gantt timeline (sized for the shortest slice)
+    int64_t min_quantum = quantum;
+    for (int i = 0; job_quanta && i < num_processes; i++) {
+        if (processes[i]->quantum > 0 && processes[i]->quantum < min_quantum) {
+            min_quantum = processes[i]->quantum;
+        }
+    }
+    int gantt_size = ganttBound(processes, num_processes, min_quantum);
+    int gantt_pid[gantt_size];
+    int64_t gantt_start[gantt_size];
+    int64_t gantt_end[gantt_size];
+    int gantt_i = 0;
+    bool gantt_idle = false;
+
+    while (completed < num_processes) {
+
+        for (int i = 0; i < num_processes; i++) {
+            if (processes[i]->arrival <= time && !processes[i]->finished && !processes[i]->visited) {
+                addNodeRR(rl, processes[i]);
+                processes[i]->visited = true;
+            }
+        }
+
+        if (!isEmpty(rl)) {
+
+            if (gantt_idle) {
+                gantt_end[gantt_i++] = time;
+                gantt_idle = false;
+            }
+
+            Process* p = removeNode(rl);
+            int64_t slice = (job_quanta && p->quantum > 0) ? p->quantum : quantum;
+
+            if (p->remaining > slice) {
+
+                gantt_start[gantt_i] = time;
+                gantt_pid[gantt_i] = p->pid;
+                time += slice;
+                gantt_end[gantt_i++] = time;
+                p->remaining -= slice;
+
+                // add all nodes that became available between quantum change
+                refAddAllNodesRR(rl, processes, num_processes, time);
+                addNodeRR(rl, p);
+
+            } else {
+
+                gantt_start[gantt_i] = time;
+                gantt_pid[gantt_i] = p->pid;
+                time += p->remaining;
+                gantt_end[gantt_i++] = time;
+                p->remaining = 0;
+                completed++;
+                p->complete = time;
+                p->turnaround = p->complete - p->arrival;
+                p->waiting = p->turnaround - p->burst;
+            }
+
+        // run idle
+        } else {
+
+            if (!gantt_idle) {
+                gantt_start[gantt_i] = time;
+                gantt_pid[gantt_i] = -1;
+            }
+            gantt_idle = true;
+            time++;
+        }
+    }
+
+    copyGantt(gantt, gantt_pid, gantt_start, gantt_end, gantt_i);
+
+    return time;
+}
+
+// add all available nodes to ready list
+void refAddAllNodesRR(RL* rl, Process** processes, int num_processes, int64_t time) {
+    for (int i = 0; i < num_processes; i++) {
+        if (processes[i]->arrival <= time && !processes[i]->finished && !processes[i]->visited) {
+            addNodeRR(rl, processes[i]);
+            processes[i]->visited = true;
+        }
+    }
+}
+
+// upper bound on gantt slices (each arrival adds at most an idle gap and a
+// preemption, round robin adds a slice per quantum)
+int ganttBound(Process** processes, int num_processes, int64_t quantum) {
+
+    int64_t bound = 3 * (int64_t) num_processes + 1;
+    for (int i = 0; quantum > 0 && i < num_processes; i++) {
+        bound += (processes[i]->burst + quantum - 1) / quantum;
+    }
+
+    return (int) bound;
+}
+
+// move a reference gantt into a Gantt for comparison
+void copyGantt(Gantt* gantt, int* gantt_pid, int64_t* gantt_start, int64_t* gantt_end, int gantt_i) {
+    for (int i = 0; i < gantt_i; i++) {
+        addSlice(gantt, gantt_pid[i], gantt_start[i], gantt_end[i]);
+    }
+}
+
+// WORKLOAD FUNCTIONS
+
+// fill processes with a random workload (unique pids, shape varies by draw);
+// returns the quantum to use for round robin (half the workloads also give
+// processes their own quanta, 0 = the run's)
+int64_t generateWorkload(Process** processes, int num_processes, uint64_t* rng) {
+
+    // pick workload shape: dense or sparse arrivals, short or long bursts
+    int64_t spans[] = { 0, 10, 100, 1000 };
+    int64_t bursts[] = { 1, 5, 20, 200 };
+    int64_t span = spans[nextRandom(rng) % 4] * num_processes / 10 + 1;
+    int64_t max_burst = bursts[nextRandom(rng) % 4];
+    int max_priority = (int) randomRange(rng, 0, 9);
+    int64_t quantum = randomRange(rng, 1, 10);
+    bool own_quanta = (nextRandom(rng) % 2 == 0);
+
+    for (int i = 0; i < num_processes; i++) {
+        Process* p = processes[i];
+        p->pid = i + 1;
+        p->arrival = randomRange(rng, 0, span);
+        p->burst = randomRange(rng, 1, max_burst);
+        p->priority = (int) randomRange(rng, 0, max_priority);
+        p->quantum = own_quanta ? randomRange(rng, 0, 10) : quantum;
+        p->remaining = p->burst;
+        p->waiting = 0;
+        p->turnaround = 0;
+        p->finished = false;
+        p->visited = false;
+    }
+
+    // shuffle so input order differs from arrival order
+    for (int i = num_processes - 1; i > 0; i--) {
+        int j = (int) (nextRandom(rng) % (uint64_t) (i + 1));
+        Process* tmp = processes[i];
+        processes[i] = processes[j];
+        processes[j] = tmp;
+    }
+
+    return quantum;
+}
+
+
+// diff an engine run (name) against the reference run; prints the first
+// divergence and returns false if they differ
+bool compareRuns(const char* name, Process** processes, int num_processes, int64_t* waiting, int64_t* turnaround, \
+    Gantt* expected, Gantt* actual, int64_t expected_end, int64_t actual_end) {
+
+    // per-job waiting/turnaround (both runs are in arrival order)
+    for (int i = 0; i < num_processes; i++) {
+        if (processes[i]->waiting != waiting[i] || processes[i]->turnaround != turnaround[i]) {
+            printf("%s: PID %d waiting/turnaround %" PRId64 "/%" PRId64 ", expected %" PRId64 "/%" PRId64 "\n", \
+                name, processes[i]->pid, processes[i]->waiting, processes[i]->turnaround, waiting[i], turnaround[i]);
+            return false;
+        }
+    }
+
+    // gantt timeline
+    for (int i = 0; i < expected->size || i < actual->size; i++) {
+
+        if (i >= actual->size || i >= expected->size || expected->pid[i] != actual->pid[i] || \
+        expected->start[i] != actual->start[i] || expected->end[i] != actual->end[i]) {
+
+            printf("%s: gantt slice %d differs\n", name, i);
+            if (i < expected->size) {
+                printf("\texpected: [  %" PRId64 "  ]-----\t%d\t-----[  %" PRId64 "  ]\n", expected->start[i], expected->pid[i], expected->end[i]);
+            }
+            if (i < actual->size) {
+                printf("\tactual:   [  %" PRId64 "  ]-----\t%d\t-----[  %" PRId64 "  ]\n", actual->start[i], actual->pid[i], actual->end[i]);
+            }
+            return false;
+        }
+    }
+
+    // end time (throughput)
+    if (expected_end != actual_end) {
+        printf("%s: schedule ends at %" PRId64 ", expected %" PRId64 "\n", name, actual_end, expected_end);
+        return false;
+    }
+
+    return true;
+}
+
+// print a workload in input file format (to reproduce a divergence)
+void printWorkload(Process** processes, int num_processes) {
+    for (int i = 0; i < num_processes; i++) {
+        printf("%d,%" PRId64 ",%" PRId64 ",%d,%" PRId64 "\n", processes[i]->pid, processes[i]->arrival, \
+            processes[i]->burst, processes[i]->priority, processes[i]->quantum);
+    }
+}
+
+// REGRESSION CHECKS
+
+// run an unsorted file with more batches than the parser's ring holds through
+// the pipelined loader: the run must stop on the unsorted input without
+// leaving the parser stuck on a full ring, and every line must still be parsed
+// for the sorted rerun
+bool checkPipeline(RL* rl) {
+
+    // input is in arrival order except for the first two lines
+    int num_processes = (SOURCE_RING_SIZE + 2) * SOURCE_BATCH;
+    Process** processes = (Process**) malloc(num_processes * sizeof(Process*));
+    Process* storage = (Process*) malloc(num_processes * sizeof(Process));
+    FILE* file = tmpfile();
+    if (processes == NULL || storage == NULL || file == NULL) {
+        printf("ERROR allocating pipeline workload\n");
+        exit(1);
+    }
+    for (int i = 0; i < num_processes; i++) {
+        int pid = (i < 2) ? 2 - i : i + 1;
+        fprintf(file, "%d,%d,1,0,1\n", pid, pid);
+        processes[i] = &storage[i];
+    }
+    rewind(file);
+
+    ArrivalSource source;
+    if (!startSource(&source, file, processes, num_processes)) {
+        printf("ERROR starting parser thread\n");
+        exit(1);
+    }
+
+    Policy policy = *findPolicy("FCFS");
+    Gantt gantt;
+    initGantt(&gantt, num_processes * 2);
+    int64_t end_time;
+    SchedStatus status = simulateWith(&policy, rl, processes, num_processes, &gantt, &end_time, NULL, NULL, &source, NULL, NULL);
+    finishSource(&source);
+    fclose(file);
+
+    bool match = true;
+    if (status != SCHED_ERR_UNSORTED) {
+        printf("pipeline: unsorted input gave \"%s\"\n", schedStatusMessage(status));
+        match = false;
+    }
+    for (int i = 0; i < num_processes && match; i++) {
+        if (processes[i]->pid != ((i < 2) ? 2 - i : i + 1)) {
+            printf("pipeline: line %d not parsed\n", i + 1);
+            match = false;
+        }
+    }
+
+    // rerun once sorted, every process runs right as it arrives
+    if (match) {
+        resetGantt(&gantt);
+        if (!sortProcesses(processes, num_processes) || \
+        simulate(&policy, rl, processes, num_processes, &gantt, &end_time) != SCHED_OK) {
+            printf("ERROR engine run failed\n");
+            exit(1);
+        }
+        if (end_time != num_processes + 1) {
+            printf("pipeline: sorted rerun ends at %" PRId64 ", expected %d\n", end_time, num_processes + 1);
+            match = false;
+        }
+    }
+
+    freeGantt(&gantt);
+    free(processes);
+    free(storage);
+
+    return match;
+}
+
+// WHAT-IF CHECKS
+
+// edits tried on each workload (each what-if result is the next edit's base)
+#define WHAT_IF_EDITS 4
+
+// run the workload under a random policy through libschedule with snapshots,
+// then apply random edits (insert at the front or anywhere, remove, change a
+// burst or priority), diffing each what-if run against a full rerun of the
+// edited workload; round robin keeps each process's own quantum
+bool checkWhatIf(Process** processes, int num_processes, int64_t quantum, uint64_t* rng, int* resumed) {
+
+    const char* policies[] = { "fcfs", "sjf", "ps", "rr" };
+    const char* policy = policies[nextRandom(rng) % 4];
+
+    // pids of processes still in the workload
+    int* pids = (int*) malloc((num_processes + WHAT_IF_EDITS) * sizeof(int));
+    SchedWorkload* workload;
+    if (pids == NULL || schedCreateWorkload(&workload) != SCHED_OK) {
+        printf("ERROR allocating what-if workload\n");
+        exit(1);
+    }
+    int num_pids = 0;
+    int64_t span = 0;
+    for (int i = 0; i < num_processes; i++) {
+        Process* p = processes[i];
+        schedAddProcess(workload, p->pid, p->arrival, p->burst, p->priority, p->quantum);
+        pids[num_pids++] = p->pid;
+        if (p->arrival > span) {
+            span = p->arrival;
+        }
+    }
+    schedSetSnapshotInterval(workload, (int) randomRange(rng, 1, 8));
+
+    SchedResult* base;
+    if (schedRunPolicy(workload, policy, quantum, &base) != SCHED_OK) {
+        printf("ERROR what-if base run failed\n");
+        exit(1);
+    }
+
+    bool match = true;
+    int next_pid = num_processes + 1;
+    for (int e = 0; e < WHAT_IF_EDITS && match; e++) {
+
+        // random edit (removals and changes need a process left to edit)
+        SchedEdit edit = { SCHED_EDIT_INSERT, 0, 0, 0, 0, 0 };
+        const char* kind = "insert at front";
+        int k = (int) (nextRandom(rng) % (uint64_t) num_pids);
+        switch (nextRandom(rng) % 5) {
+            case 0:
+                break;
+            case 1:
+                kind = "insert";
+                edit.arrival = randomRange(rng, 0, span);
+                break;
+            case 2:
+                if (num_pids > 1) {
+                    kind = "remove";
+                    edit.kind = SCHED_EDIT_REMOVE;
+                    edit.pid = pids[k];
+                    pids[k] = pids[--num_pids];
+                }
+                break;
+            case 3:
+                kind = "burst";
+                edit.kind = SCHED_EDIT_BURST;
+                edit.pid = pids[k];
+                edit.burst = randomRange(rng, 1, 20);
+                break;
+            default:
+                kind = "priority";
+                edit.kind = SCHED_EDIT_PRIORITY;
+                edit.pid = pids[k];
+                edit.priority = (int) randomRange(rng, 0, 9);
+                break;
+        }
+        if (edit.kind == SCHED_EDIT_INSERT) {
+            edit.pid = next_pid++;
+            edit.burst = randomRange(rng, 1, 20);
+            edit.priority = (int) randomRange(rng, 0, 9);
+            edit.quantum = randomRange(rng, 0, 10);
+            pids[num_pids++] = edit.pid;
+        }
+
+        // what-if run vs full rerun of the edited workload
+        SchedResult* what_if;
+        SchedResult* full;
+        SchedDelta delta;
+        if (schedWhatIf(workload, base, &edit, &what_if, &delta) != SCHED_OK || \
+        schedRunPolicy(workload, policy, quantum, &full) != SCHED_OK) {
+            printf("ERROR what-if run failed\n");
+            exit(1);
+        }
+        if (delta.resumed_at > 0) {
+            (*resumed)++;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "what-if %s %s PID %d", policy, kind, edit.pid);
+        match = compareResults(name, what_if, full);
+        if (match && delta.changed_jobs != schedChangedJobs(what_if)) {
+            printf("%s: delta lists %d changed jobs, result %d\n", name, delta.changed_jobs, schedChangedJobs(what_if));
+            match = false;
+        }
+
+        schedFreeResult(full);
+        schedFreeResult(base);
+        base = what_if;
+    }
+
+    schedFreeResult(base);
+    schedFreeWorkload(workload);
+    free(pids);
+
+    return match;
+}
+
+// diff a what-if result against a full run; prints the first divergence and
+// returns false if they differ
+bool compareResults(const char* name, const SchedResult* what_if, const SchedResult* full) {
+
+    // jobs (field by field, padding may differ)
+    if (schedResultJobs(what_if) != schedResultJobs(full)) {
+        printf("%s: %d jobs, expected %d\n", name, schedResultJobs(what_if), schedResultJobs(full));
+        return false;
+    }
+    for (int i = 0; i < schedResultJobs(full); i++) {
+        SchedJob a, b;
+        schedResultJob(what_if, i, &a);
+        schedResultJob(full, i, &b);
+        if (a.pid != b.pid || a.arrival != b.arrival || a.burst != b.burst || a.priority != b.priority || \
+        a.start != b.start || a.complete != b.complete || a.waiting != b.waiting || a.turnaround != b.turnaround) {
+            printf("%s: job %d (PID %d) start/complete %" PRId64 "/%" PRId64 ", expected PID %d %" PRId64 "/%" PRId64 "\n", \
+                name, i, a.pid, a.start, a.complete, b.pid, b.start, b.complete);
+            return false;
+        }
+    }
+
+    // gantt timeline
+    if (schedResultSlices(what_if) != schedResultSlices(full)) {
+        printf("%s: %d gantt slices, expected %d\n", name, schedResultSlices(what_if), schedResultSlices(full));
+        return false;
+    }
+    for (int i = 0; i < schedResultSlices(full); i++) {
+        SchedSlice a, b;
+        schedResultSlice(what_if, i, &a);
+        schedResultSlice(full, i, &b);
+        if (a.pid != b.pid || a.start != b.start || a.end != b.end) {
+            printf("%s: gantt slice %d differs\n", name, i);
+            printf("\texpected: [  %" PRId64 "  ]-----\t%d\t-----[  %" PRId64 "  ]\n", b.start, b.pid, b.end);
+            printf("\tactual:   [  %" PRId64 "  ]-----\t%d\t-----[  %" PRId64 "  ]\n", a.start, a.pid, a.end);
+            return false;
+        }
+    }
+
+    // end time (throughput)
+    SchedSummary a, b;
+    schedResultSummary(what_if, &a);
+    schedResultSummary(full, &b);
+    if (a.end_time != b.end_time) {
+        printf("%s: schedule ends at %" PRId64 ", expected %" PRId64 "\n", name, a.end_time, b.end_time);
+        return false;
+    }
+
+    return true;
+}
+
+// MAIN CALL
+int main(int argc, char* argv[]) {
+
+    // read harness settings
+    int iterations = (argc > 1) ? atoi(argv[1]) : 2000;
+    uint64_t seed = (argc > 2) ? strtoull(argv[2], NULL, 10) : 1;
+    int max_processes = (argc > 3) ? atoi(argv[3]) : 200;
+
+    if (iterations <= 0 || max_processes <= 0) {
+        printf("INVALID CALL -- Usage ... ./validate [iterations] [seed] [max processes]\n");
+        exit(1);
+    }
+
+    // schedulers under test (the original round robin gives every job the same
+    // quantum, "RR JOB" uses each job's own)
+    Variant variants[] = {
+        { "FCFS", refFcfs, { "FCFS", addNodeRR, removeNode, NULL, 0, false }, 0, 0 },
+        { "SJF", refSjf, { "SJF", addNode, removeNode, preemptShorter, 0, false }, 0, 0 },
+        { "PS", refPs, { "PS", addNodeRR, removeNodePriority, NULL, 0, false }, 0, 0 },
+        { "RR", refRr, { "RR", addNodeRR, removeNode, NULL, 0, false }, 0, 0 },
+        { "RR JOB", refRrJob, { "RR", addNodeRR, removeNode, NULL, 0, true }, 0, 0 },
+    };
+    int num_variants = sizeof(variants) / sizeof(Variant);
+
+    // allocate workload storage for the largest workload
+    Process** processes = (Process**) malloc(max_processes * sizeof(Process*));
+    Process* storage = (Process*) malloc(max_processes * sizeof(Process));
+    int64_t* waiting = (int64_t*) malloc(max_processes * sizeof(int64_t));
+    int64_t* turnaround = (int64_t*) malloc(max_processes * sizeof(int64_t));
+    if (processes == NULL || storage == NULL || waiting == NULL || turnaround == NULL) {
+        printf("ERROR allocating memory for workloads\n");
+        exit(1);
+    }
+
+    RL rl;
+    initRL(&rl);
+
+    // one cpu without penalties (must match the single-cpu engine)
+    Machine one_cpu = { 1, 0, 0, true, 0, 0, 0 };
+
+    // what-if runs that started from a snapshot
+    int resumed = 0;
+
+    for (int it = 0; it < iterations; it++) {
+
+        // seed each workload separately so a failure can be replayed alone
+        uint64_t rng = (seed + it) * 0x9E3779B97F4A7C15ULL + 1;
+        int num_processes = (int) randomRange(&rng, 1, max_processes);
+        for (int i = 0; i < num_processes; i++) {
+            processes[i] = &storage[i];
+        }
+        int64_t quantum = generateWorkload(processes, num_processes, &rng);
+
+        for (int v = 0; v < num_variants; v++) {
+
+            Variant* variant = &variants[v];
+            variant->policy.quantum = (strcmp(variant->policy.name, "RR") == 0) ? quantum : 0;
+
+            // reference run
+            Gantt expected;
+            initGantt(&expected, num_processes * 2);
+            double start = wallTime();
+            int64_t expected_end = variant->reference(&rl, processes, num_processes, quantum, &expected);
+            variant->reference_secs += wallTime() - start;
+
+            for (int i = 0; i < num_processes; i++) {
+                waiting[i] = processes[i]->waiting;
+                turnaround[i] = processes[i]->turnaround;
+            }
+
+            // engine run (from input order, like the command line)
+            Gantt actual;
+            initGantt(&actual, num_processes * 2);
+            start = wallTime();
+            int64_t actual_end;
+            if (!sortProcesses(processes, num_processes) || \
+            simulate(&variant->policy, &rl, processes, num_processes, &actual, &actual_end) != SCHED_OK) {
+                printf("ERROR engine run failed\n");
+                exit(1);
+            }
+            variant->engine_secs += wallTime() - start;
+
+            // stop at first divergence
+            if (!compareRuns(variant->name, processes, num_processes, waiting, turnaround, &expected, &actual, expected_end, actual_end)) {
+                printf("Divergence at iteration %d (seed %" PRIu64 "), workload:\n", it, seed + it);
+                printWorkload(processes, num_processes);
+                exit(1);
+            }
+
+            // multi-cpu engine with one cpu and no penalties
+            Gantt single;
+            initGantt(&single, num_processes * 2);
+            int64_t single_end;
+            if (simulateCpus(&variant->policy, &rl, processes, num_processes, &single, &single_end, &one_cpu) != SCHED_OK) {
+                printf("ERROR multi-cpu engine run failed\n");
+                exit(1);
+            }
+            char name[32];
+            snprintf(name, sizeof(name), "%s (1 CPU)", variant->name);
+            if (!compareRuns(name, processes, num_processes, waiting, turnaround, &expected, &single, expected_end, single_end)) {
+                printf("Divergence at iteration %d (seed %" PRIu64 "), workload:\n", it, seed + it);
+                printWorkload(processes, num_processes);
+                exit(1);
+            }
+
+            freeGantt(&expected);
+            freeGantt(&actual);
+            freeGantt(&single);
+        }
+
+        // incremental what-if runs vs full reruns
+        if (!checkWhatIf(processes, num_processes, quantum, &rng, &resumed)) {
+            printf("Divergence at iteration %d (seed %" PRIu64 "), workload before edits:\n", it, seed + it);
+            printWorkload(processes, num_processes);
+            exit(1);
+        }
+    }
+
+    // pipelined loading past a full ring
+    if (!checkPipeline(&rl)) {
+        exit(1);
+    }
+
+    // display speedup of engine over reference per scheduler
+    printf("%d workloads (up to %d processes) match, on the single-cpu and 1-cpu engines\n", iterations, max_processes);
+    printf("%d what-if edits match full reruns (%d resumed from a snapshot)\n", iterations * WHAT_IF_EDITS, resumed);
+    printf("Pipelined loading of %d unsorted lines stops and reloads\n\n", (SOURCE_RING_SIZE + 2) * SOURCE_BATCH);
+    printf("\tPolicy\t|\tReference (s)\t|\tEngine (s)\t|\tSpeedup\n");
+    for (int v = 0; v < num_variants; v++) {
+        printf("\t%s\t|\t%.6f\t|\t%.6f\t|\t%.2fx\n", variants[v].name, variants[v].reference_secs, \
+            variants[v].engine_secs, variants[v].reference_secs / variants[v].engine_secs);
+    }
+    printf("\n");
+
+    freeRL(&rl);
+    free(processes);
+    free(storage);
+    free(waiting);
+    free(turnaround);
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "wheel.h"
+
+// find the level a timer belongs on: the highest 6-bit digit where its
+// expiry differs from now (lower levels always expire sooner)
+static int timerLevel(int64_t now, int64_t expires) {
+
+    uint64_t diff = (uint64_t) expires ^ (uint64_t) now;
+
+    if (diff == 0) {
+        return 0;
+    }
+
+    return (63 - __builtin_clzll(diff)) / WHEEL_BITS;
+}
+
+// link timer at the tail of its slot (keeps insertion order)
+static void fileTimer(Wheel* wheel, Timer* timer) {
+
+    // timers already due are filed at now
+    int64_t at = (timer->expires < wheel->now) ? wheel->now : timer->expires;
+
+    timer->level = timerLevel(wheel->now, at);
+    timer->slot = (int) (((uint64_t) at >> (timer->level * WHEEL_BITS)) & (WHEEL_SLOTS - 1));
+
+    Timer* head = &wheel->slots[timer->level][timer->slot];
+    timer->next = head;
+    timer->prev = head->prev;
+    head->prev->next = timer;
+    head->prev = timer;
+
+    wheel->occupied[timer->level] |= 1ULL << timer->slot;
+}
+
+// unlink timer from its slot
+static void unfileTimer(Wheel* wheel, Timer* timer) {
+
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+    timer->next = NULL;
+    timer->prev = NULL;
+
+    // clear slot bit if slot is now empty
+    Timer* head = &wheel->slots[timer->level][timer->slot];
+    if (head->next == head) {
+        wheel->occupied[timer->level] &= ~(1ULL << timer->slot);
+    }
+}
+
+// initialize an empty wheel starting at time now
+void initWheel(Wheel* wheel, int64_t now) {
+
+    wheel->now = now;
+
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < WHEEL_SLOTS; slot++) {
+            wheel->slots[level][slot].next = &wheel->slots[level][slot];
+            wheel->slots[level][slot].prev = &wheel->slots[level][slot];
+        }
+        wheel->occupied[level] = 0;
+    }
+}
+
+// schedule timer to fire at expires (O(1), a pending timer is rescheduled)
+void addTimer(Wheel* wheel, Timer* timer, int64_t expires) {
+
+    // take a pending timer out of its old slot first
+    cancelTimer(wheel, timer);
+
+    timer->expires = expires;
+    fileTimer(wheel, timer);
+}
+
+// remove a pending timer without firing it (O(1), no-op if not pending)
+void cancelTimer(Wheel* wheel, Timer* timer) {
+    if (isPending(timer)) {
+        unfileTimer(wheel, timer);
+    }
+}
+
+// check if timer is waiting in a wheel
+bool isPending(Timer* timer) {
+    return timer->next != NULL;
+}
+
+// expiry of the earliest pending timer, cascading higher-level slots down
+// until it sits on level 0; slots starting after limit are left alone (now
+// never passes limit) and their start is returned instead
+static int64_t earliestBy(Wheel* wheel, int64_t limit) {
+
+    while (true) {
+
+        // find lowest non-empty level
+        int level = 0;
+        while (level < WHEEL_LEVELS && wheel->occupied[level] == 0) {
+            level++;
+        }
+        if (level == WHEEL_LEVELS) {
+            return INT64_MAX;
+        }
+
+        // earliest slot on the level
+        int slot = __builtin_ctzll(wheel->occupied[level]);
+
+        // level 0 slots hold a single expiry time
+        if (level == 0) {
+            return (int64_t) (((uint64_t) wheel->now & ~(uint64_t) (WHEEL_SLOTS - 1)) | (uint64_t) slot);
+        }
+
+        // start of the slot (nothing pending expires before it)
+        int shift = level * WHEEL_BITS;
+        uint64_t upper = 0;
+        if (shift + WHEEL_BITS < 64) {
+            upper = ((uint64_t) wheel->now >> (shift + WHEEL_BITS)) << (shift + WHEEL_BITS);
+        }
+        int64_t start = (int64_t) (upper | ((uint64_t) slot << shift));
+        if (start > limit) {
+            return start;
+        }
+
+        // move now to the slot start, detach slot list and refile its
+        // timers (in order) on lower levels
+        wheel->now = start;
+        Timer* head = &wheel->slots[level][slot];
+        Timer* timer = head->next;
+        head->next = head;
+        head->prev = head;
+        wheel->occupied[level] &= ~(1ULL << slot);
+
+        while (timer != head) {
+            Timer* next = timer->next;
+            fileTimer(wheel, timer);
+            timer = next;
+        }
+    }
+}
+
+// expiry of the earliest pending timer (INT64_MAX if none); may advance now
+// up to it, so later timers must not expire before the returned time
+int64_t nextTimer(Wheel* wheel) {
+    return earliestBy(wheel, INT64_MAX);
+}
+
+// remove and return the earliest timer if it expires by time (NULL otherwise)
+Timer* popTimer(Wheel* wheel, int64_t time) {
+
+    int64_t expires = earliestBy(wheel, time);
+    if (expires > time) {
+        return NULL;
+    }
+
+    // advance to the timer's expiry and take the head of its slot
+    wheel->now = expires;
+    Timer* timer = wheel->slots[0][expires & (WHEEL_SLOTS - 1)].next;
+    unfileTimer(wheel, timer);
+
+    return timer;
+}
@@ -0,0 +1,40 @@
+#ifndef WHEEL_H
+#define WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// hierarchical timing wheel: level L has 64 slots of 64^L ticks each,
+// 11 levels cover the full 64-bit clock
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS 11
+
+// a timer (linked into a wheel slot while pending)
+typedef struct Timer {
+    int64_t expires;        // time the timer fires
+    void* data;             // caller's payload
+    struct Timer* next;     // slot list links (NULL = not pending)
+    struct Timer* prev;
+    int level;              // slot the timer is filed under
+    int slot;
+} Timer;
+
+// timing wheel (timers expiring at the same time fire in insertion order);
+// timers added must not expire before the last time returned by nextTimer()
+// or passed to popTimer()
+typedef struct Wheel {
+    int64_t now;                                // no pending timer expires before now
+    Timer slots[WHEEL_LEVELS][WHEEL_SLOTS];     // list heads (circular)
+    uint64_t occupied[WHEEL_LEVELS];            // bitmap of non-empty slots per level
+} Wheel;
+
+// WHEEL FUNCTION PROTOTYPES
+void initWheel(Wheel* wheel, int64_t now);
+void addTimer(Wheel* wheel, Timer* timer, int64_t expires);
+void cancelTimer(Wheel* wheel, Timer* timer);
+bool isPending(Timer* timer);
+int64_t nextTimer(Wheel* wheel);
+Timer* popTimer(Wheel* wheel, int64_t time);
+
+#endif